@@ -230,9 +230,309 @@ void StriBrkIterOptions::setSkipRuleStatus(SEXP opts_brkiter) {
 }
 
 
+/* ASCII fast path for word and sentence boundary analysis.
+ *
+ * ICU's rule-based break iterators are quite slow on short texts.
+ * For pure ASCII strings, the UAX #29 word and sentence rules
+ * (as implemented in ICU's root locale) reduce to the simple
+ * character classes below. StriBrkIterCache checks each prototype
+ * against ICU's results on a sample text before enabling this path
+ * (the rules differ between ICU versions and locales: e.g.,
+ * the colon joins words in Swedish and Finnish).
+ *
+ * Word boundaries: WB1-WB3b, WB3d (ICU >= 62 only, Unicode 11),
+ * WB5-WB7, WB8-WB12, WB13a, WB13b, and WB999. The remaining rules
+ * never apply to ASCII text (WB3c, WB4, WB7a-WB7c, WB13, WB15, WB16).
+ * Rule status (ICU's extension): UBRK_WORD_LETTER, UBRK_WORD_NUMBER
+ * or UBRK_WORD_NONE, depending on the last segment's character.
+ *
+ * Sentence boundaries: SB1-SB4, SB6-SB11, and SB998 (SB5 never applies);
+ * rule status: UBRK_SENTENCE_TERM or UBRK_SENTENCE_SEP.
+ *
+ * Each character class used above is exercised by the sample
+ * in stri__brkiter_ascii_check(), so the sample must be extended
+ * whenever the mapping changes.
+ */
+
+enum { // Word_Break property values of ASCII characters (ICU's flavour)
+   STRI__WB_OTHER=0, STRI__WB_CR, STRI__WB_LF, STRI__WB_NEWLINE,
+   STRI__WB_ALETTER, STRI__WB_NUMERIC, STRI__WB_MIDNUM, STRI__WB_MIDNUMLET,
+   STRI__WB_SINGLEQUOTE, STRI__WB_DOUBLEQUOTE, STRI__WB_EXTENDNUMLET,
+   STRI__WB_WSEGSPACE
+};
+
+
+enum { // Sentence_Break property values of ASCII characters
+   STRI__SB_OTHER=0, STRI__SB_CR, STRI__SB_LF, STRI__SB_SP, STRI__SB_LOWER,
+   STRI__SB_UPPER, STRI__SB_NUMERIC, STRI__SB_ATERM, STRI__SB_STERM,
+   STRI__SB_CLOSE, STRI__SB_SCONTINUE
+};
+
+
+static inline int stri__brkiter_ascii_wb(char c) {
+   // ICU's word rules: $ALetter = [\p{Word_Break = ALetter} @]
+   if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '@') return STRI__WB_ALETTER;
+   if (c >= '0' && c <= '9') return STRI__WB_NUMERIC;
+   switch (c) {
+      case '\r': return STRI__WB_CR;
+      case '\n': return STRI__WB_LF;
+      case '\v': case '\f': return STRI__WB_NEWLINE;
+      case ',': case ';': return STRI__WB_MIDNUM;
+      case '.':  return STRI__WB_MIDNUMLET;
+      case '\'': return STRI__WB_SINGLEQUOTE;
+      case '"':  return STRI__WB_DOUBLEQUOTE;
+      case '_':  return STRI__WB_EXTENDNUMLET;
+      case ' ':  return STRI__WB_WSEGSPACE;
+      default:   return STRI__WB_OTHER; // ':' is not a MidLetter in ICU's root locale
+   }
+}
+
+
+static inline int stri__brkiter_ascii_sb(char c) {
+   if (c >= 'a' && c <= 'z') return STRI__SB_LOWER;
+   if (c >= 'A' && c <= 'Z') return STRI__SB_UPPER;
+   if (c >= '0' && c <= '9') return STRI__SB_NUMERIC;
+   switch (c) {
+      case '\r': return STRI__SB_CR;
+      case '\n': return STRI__SB_LF;
+      case '\t': case '\v': case '\f': case ' ': return STRI__SB_SP;
+      case '.': return STRI__SB_ATERM;
+      case '!': case '?': return STRI__SB_STERM;
+      case '"': case '\'': case '(': case ')':
+      case '[': case ']': case '{': case '}': return STRI__SB_CLOSE;
+      case ',': case '-': case ':': return STRI__SB_SCONTINUE;
+      default: return STRI__SB_OTHER;
+   }
+}
+
+
+/** Word boundaries in an ASCII string
+ *
+ * @param s ASCII string
+ * @param n length of s
+ * @param out [out] boundaries and the corresponding rule statuses,
+ *    in the same form as reported by ICU's BreakIterator
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static void stri__brkiter_ascii_word(const char* s, R_len_t n,
+   std::vector< std::pair<R_len_t, int> >& out)
+{
+   out.clear();
+   out.push_back(std::pair<R_len_t, int>(0, 0));
+   if (n <= 0) return;
+
+   std::vector<int> wb(n);
+   for (R_len_t i=0; i<n; ++i) wb[i] = stri__brkiter_ascii_wb(s[i]);
+
+   R_len_t start = 0;
+   for (R_len_t i=1; i<=n; ++i) {
+      bool brk = true; // WB999
+      if (i < n) {
+         int a  = wb[i-1];
+         int b  = wb[i];
+         int aa = (i >= 2)?wb[i-2]:-1;
+         int bb = (i+1 < n)?wb[i+1]:-1;
+         bool a_mid  = (a == STRI__WB_MIDNUMLET || a == STRI__WB_SINGLEQUOTE);
+         bool b_mid  = (b == STRI__WB_MIDNUMLET || b == STRI__WB_SINGLEQUOTE);
+         bool a_alnum = (a == STRI__WB_ALETTER || a == STRI__WB_NUMERIC);
+         bool b_alnum = (b == STRI__WB_ALETTER || b == STRI__WB_NUMERIC);
+
+         if (a == STRI__WB_CR && b == STRI__WB_LF)
+            brk = false; // WB3
+         else if (a == STRI__WB_CR || a == STRI__WB_LF || a == STRI__WB_NEWLINE)
+            brk = true;  // WB3a
+         else if (b == STRI__WB_CR || b == STRI__WB_LF || b == STRI__WB_NEWLINE)
+            brk = true;  // WB3b
+#if U_ICU_VERSION_MAJOR_NUM >= 62
+         else if (a == STRI__WB_WSEGSPACE && b == STRI__WB_WSEGSPACE)
+            brk = false; // WB3d
+#endif
+         else if (a_alnum && b_alnum)
+            brk = false; // WB5, WB8, WB9, WB10
+         else if (a == STRI__WB_ALETTER && b_mid && bb == STRI__WB_ALETTER)
+            brk = false; // WB6
+         else if (aa == STRI__WB_ALETTER && a_mid && b == STRI__WB_ALETTER)
+            brk = false; // WB7
+         else if (aa == STRI__WB_NUMERIC && (a_mid || a == STRI__WB_MIDNUM) && b == STRI__WB_NUMERIC)
+            brk = false; // WB11
+         else if (a == STRI__WB_NUMERIC && (b_mid || b == STRI__WB_MIDNUM) && bb == STRI__WB_NUMERIC)
+            brk = false; // WB12
+         else if ((a_alnum || a == STRI__WB_EXTENDNUMLET) && b == STRI__WB_EXTENDNUMLET)
+            brk = false; // WB13a
+         else if (a == STRI__WB_EXTENDNUMLET && b_alnum)
+            brk = false; // WB13b
+      }
+      if (!brk) continue;
+
+      // rule status: determined by the last character (and the one before it)
+      int status = UBRK_WORD_NONE;
+      if (wb[i-1] == STRI__WB_ALETTER)
+         status = UBRK_WORD_LETTER;
+      else if (wb[i-1] == STRI__WB_NUMERIC)
+         status = UBRK_WORD_NUMBER;
+      else if (wb[i-1] == STRI__WB_EXTENDNUMLET && i-1 > start)
+         status = (wb[i-2] == STRI__WB_NUMERIC)?UBRK_WORD_NUMBER:UBRK_WORD_LETTER;
+
+      out.push_back(std::pair<R_len_t, int>(i, status));
+      start = i;
+   }
+}
+
+
+/** Sentence boundaries in an ASCII string
+ *
+ * @param s ASCII string
+ * @param n length of s
+ * @param out [out] boundaries and the corresponding rule statuses,
+ *    in the same form as reported by ICU's BreakIterator
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static void stri__brkiter_ascii_sentence(const char* s, R_len_t n,
+   std::vector< std::pair<R_len_t, int> >& out)
+{
+   out.clear();
+   out.push_back(std::pair<R_len_t, int>(0, 0));
+   if (n <= 0) return;
+
+   std::vector<int> sb(n);
+   for (R_len_t i=0; i<n; ++i) sb[i] = stri__brkiter_ascii_sb(s[i]);
+
+   // lower[i] - is the first character at position >= i that is not
+   // an Other, Numeric, Sp, Close, or SContinue one a Lower one? (for SB8)
+   std::vector<bool> lower(n+1);
+   lower[n] = false;
+   for (R_len_t i=n-1; i>=0; --i) {
+      int c = sb[i];
+      if (c == STRI__SB_OTHER || c == STRI__SB_NUMERIC || c == STRI__SB_SP
+            || c == STRI__SB_CLOSE || c == STRI__SB_SCONTINUE)
+         lower[i] = lower[i+1];
+      else
+         lower[i] = (c == STRI__SB_LOWER);
+   }
+
+   // the text before i matches SATerm Close* Sp* ParaSep? -> term is ATerm
+   // or STerm (otherwise -1) and sp states whether there were any Sp
+   int term = -1;
+   bool sp = false;
+   for (R_len_t i=1; i<=n; ++i) {
+      int a = sb[i-1];
+      bool parasep = (a == STRI__SB_CR || a == STRI__SB_LF);
+      if (a == STRI__SB_ATERM || a == STRI__SB_STERM) {
+         term = a;
+         sp = false;
+      }
+      else if (a == STRI__SB_CLOSE) {
+         if (sp) term = -1;
+      }
+      else if (a == STRI__SB_SP) {
+         sp = true;
+      }
+      else if (!parasep)
+         term = -1;
+
+      bool brk = true; // end of text
+      if (i < n) {
+         int b = sb[i];
+         if (a == STRI__SB_CR && b == STRI__SB_LF)
+            brk = false; // SB3
+         else if (parasep)
+            brk = true;  // SB4
+         else if (a == STRI__SB_ATERM && b == STRI__SB_NUMERIC)
+            brk = false; // SB6
+         else if (a == STRI__SB_ATERM && b == STRI__SB_UPPER && i >= 2
+               && (sb[i-2] == STRI__SB_UPPER || sb[i-2] == STRI__SB_LOWER))
+            brk = false; // SB7
+         else if (term < 0)
+            brk = false; // SB998
+         else if (term == STRI__SB_ATERM && lower[i])
+            brk = false; // SB8
+         else if (b == STRI__SB_SCONTINUE || b == STRI__SB_ATERM || b == STRI__SB_STERM)
+            brk = false; // SB8a
+         else if (!sp && b == STRI__SB_CLOSE)
+            brk = false; // SB9
+         else if (b == STRI__SB_SP || b == STRI__SB_CR || b == STRI__SB_LF)
+            brk = false; // SB9, SB10
+         else
+            brk = true;  // SB11
+      }
+      if (!brk) continue;
+
+      out.push_back(std::pair<R_len_t, int>(i,
+         (term >= 0)?UBRK_SENTENCE_TERM:UBRK_SENTENCE_SEP));
+      term = -1;
+      sp = false;
+   }
+}
+
+
+/* runs of spaces in stri__brkiter_ascii_check()'s sample (WB3d) */
+#if U_ICU_VERSION_MAJOR_NUM >= 62
+#define STRI__BRKITER_SAMPLE_SP2 "  "
+#else
+#define STRI__BRKITER_SAMPLE_SP2 " "
+#endif
+
+
+/** Check if stri__brkiter_ascii_* give the same results as a given
+ *  break iterator
+ *
+ * @param brkiter break iterator
+ * @param type UBRK_WORD or UBRK_SENTENCE
+ * @return true if the fast path may be used instead of brkiter
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static bool stri__brkiter_ascii_check(BreakIterator* brkiter, UBreakIteratorType type)
+{
+   if (type != UBRK_WORD && type != UBRK_SENTENCE)
+      return false;
+
+   const char* sample =
+      "The U.S.A. isn't 3.14, e.g. 1,000;a:b x_y __ _1 a_1 \"Hi!\" (ok.) he said." STRI__BRKITER_SAMPLE_SP2
+      "Then? no..." STRI__BRKITER_SAMPLE_SP2 "A. b. 12. Ab.Cd. etc.)" STRI__BRKITER_SAMPLE_SP2 "[x] {y} - z: 4;5 'q'\r\n"
+      "mail me at a.b@c.org, @x @ @[. ok\r\n"
+      "new\n\v\fline\t.\t?\r!\r\n. ";
+   R_len_t sample_n = (R_len_t)strlen(sample);
+
+   std::vector< std::pair<R_len_t, int> > expected;
+   if (type == UBRK_WORD)
+      stri__brkiter_ascii_word(sample, sample_n, expected);
+   else
+      stri__brkiter_ascii_sentence(sample, sample_n, expected);
+
+   BreakIterator* test = brkiter->clone();
+   if (!test) throw StriException(MSG__MEM_ALLOC_ERROR);
+   UErrorCode status = U_ZERO_ERROR;
+   UText* text = utext_openUTF8(NULL, sample, sample_n, &status);
+   STRI__CHECKICUSTATUS_THROW(status, {delete test;})
+   test->setText(text, status);
+   STRI__CHECKICUSTATUS_THROW(status, {utext_close(text); delete test;})
+
+   bool ok = true;
+   size_t k = 0;
+   for (R_len_t pos = test->first(); pos != BreakIterator::DONE; pos = test->next(), ++k) {
+      if (k >= expected.size() || expected[k].first != pos
+            || expected[k].second != test->getRuleStatus()) {
+         ok = false;
+         break;
+      }
+   }
+   ok = ok && (k == expected.size());
+
+   utext_close(text);
+   delete test;
+   return ok;
+}
+
+
 /**
  *
  * @ version 0.4-1 (Marek Gagolewski, 2014-12-03)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    ASCII fast path
  */
 void StriRuleBasedBreakIterator::setupMatcher(const char* _searchStr, R_len_t _searchLen)
 {
@@ -242,6 +542,22 @@ void StriRuleBasedBreakIterator::setupMatcher(const char* _searchStr, R_len_t _s
    this->searchLen = _searchLen;
    this->searchPos = BreakIterator::DONE;
 
+   this->asciiMode = false;
+   if (this->asciiFastPath) {
+      R_len_t i = 0;
+      while (i < _searchLen && (uint8_t)_searchStr[i] < 0x80) ++i;
+      this->asciiMode = (i == _searchLen);
+   }
+
+   if (this->asciiMode) {
+      if (type == UBRK_WORD)
+         stri__brkiter_ascii_word(_searchStr, _searchLen, this->asciiBoundaries);
+      else
+         stri__brkiter_ascii_sentence(_searchStr, _searchLen, this->asciiBoundaries);
+      this->asciiIndex = 0;
+      return;
+   }
+
    UErrorCode status = U_ZERO_ERROR;
    this->searchText = utext_openUTF8(this->searchText,
       _searchStr, _searchLen, &status);
@@ -263,16 +579,20 @@ void StriRuleBasedBreakIterator::setupMatcher(const char* _searchStr, R_len_t _s
  *
  * @version 0.4-1 (Marek Gagolews, 2014-12-03)
  *    moved to StriRuleBasedBreakIterator
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    ASCII fast path
  */
 bool StriRuleBasedBreakIterator::ignoreBoundary() {
 #ifndef NDEBUG
-   if (!rbiterator || !searchText)
+   if (!rbiterator || (!searchText && !asciiMode))
       throw StriException("!NDEBUG: StriRuleBasedBreakIterator::ignoreBoundary()");
 #endif
 
    if (skip_size <= 0) return false;
 
-   int rule = rbiterator->getRuleStatus();   /* this is ICU 52 */
+   int rule = (asciiMode)?asciiBoundaries[asciiIndex].second
+      :rbiterator->getRuleStatus();   /* this is ICU 52 */
    for (int i=0; i<skip_size; i += 2) {
       // skip_size is even - that's sure
       if (rule >= skip_rules[i] && rule < skip_rules[i+1])
@@ -294,6 +614,12 @@ void StriRuleBasedBreakIterator::first()
       throw StriException("!NDEBUG: StriRuleBasedBreakIterator::first");
 #endif
 
+   if (asciiMode) {
+      asciiIndex = 0;
+      this->searchPos = asciiBoundaries[0].first;
+      return;
+   }
+
    this->searchPos = rbiterator->first(); // ICU man: "The offset of the beginning of the text, zero."
 
 #ifndef NDBEGUG
@@ -309,6 +635,17 @@ void StriRuleBasedBreakIterator::first()
  */
 bool StriRuleBasedBreakIterator::next()
 {
+   if (asciiMode) {
+      while (++asciiIndex < (R_len_t)asciiBoundaries.size()) {
+         this->searchPos = asciiBoundaries[asciiIndex].first;
+         if (!ignoreBoundary())
+            return true;
+      }
+      asciiIndex = (R_len_t)asciiBoundaries.size()-1; // stay at the end
+      this->searchPos = BreakIterator::DONE;
+      return false;
+   }
+
    while ((this->searchPos = rbiterator->next()) != BreakIterator::DONE) {
       if (!ignoreBoundary())
          return true;
@@ -324,6 +661,22 @@ bool StriRuleBasedBreakIterator::next()
 bool StriRuleBasedBreakIterator::next(std::pair<R_len_t, R_len_t>& bdr)
 {
    R_len_t lastPos = searchPos;
+   if (asciiMode) {
+      while (++asciiIndex < (R_len_t)asciiBoundaries.size()) {
+         searchPos = asciiBoundaries[asciiIndex].first;
+         if (!ignoreBoundary()) {
+            bdr.first  = lastPos;
+            bdr.second = searchPos;
+            return true;
+         }
+
+         lastPos = searchPos;
+      }
+      asciiIndex = (R_len_t)asciiBoundaries.size()-1; // stay at the end
+      searchPos = BreakIterator::DONE;
+      return false;
+   }
+
    while ((searchPos = rbiterator->next()) != BreakIterator::DONE) {
       if (!ignoreBoundary()) {
          bdr.first  = lastPos;
@@ -350,6 +703,12 @@ void StriRuleBasedBreakIterator::last()
       throw StriException("!NDEBUG: StriRuleBasedBreakIterator::last");
 #endif
 
+   if (asciiMode) {
+      asciiIndex = (R_len_t)asciiBoundaries.size()-1;
+      this->searchPos = asciiBoundaries[asciiIndex].first;
+      return;
+   }
+
    rbiterator->first();
    this->searchPos = rbiterator->last(); // ICU man: "The text's past-the-end offset. "
 
@@ -366,6 +725,20 @@ void StriRuleBasedBreakIterator::last()
  */
 bool StriRuleBasedBreakIterator::previous(std::pair<R_len_t, R_len_t>& bdr)
 {
+   if (asciiMode) {
+      while (asciiIndex > 0) {
+         if (!ignoreBoundary()) {
+            bdr.second = searchPos;
+            searchPos = asciiBoundaries[--asciiIndex].first;
+            bdr.first = searchPos;
+            return true;
+         }
+         searchPos = asciiBoundaries[--asciiIndex].first;
+      }
+      searchPos = BreakIterator::DONE;
+      return false;
+   }
+
    do {
       if (!ignoreBoundary()) {
          bdr.second  = searchPos;
@@ -379,3 +752,185 @@ bool StriRuleBasedBreakIterator::previous(std::pair<R_len_t, R_len_t>& bdr)
    while (searchPos != BreakIterator::DONE);
    return false;
 }
+
+
+std::deque<StriBrkIterCache::Entry*> StriBrkIterCache::entries;
+
+
+/** Find (or create) the cache entry for given break iterator options
+ *
+ * The entry is moved to the front of the cache;
+ * the least recently used one may be evicted.
+ *
+ * @param type break iterator type (ignored if rules are given)
+ * @param locale locale ID, NULL for the default one (ignored if rules are given)
+ * @param rules custom rules or an empty string
+ * @return cache entry
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriBrkIterCache::Entry* StriBrkIterCache::getEntry(UBreakIteratorType type,
+   const char* locale, const UnicodeString& rules)
+{
+   std::string loc;
+   if (rules.isEmpty())
+      loc = (locale)?locale:uloc_getDefault();
+   else
+      type = UBRK_CHARACTER; // not used
+
+   for (std::deque<Entry*>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      Entry* e = *it;
+      if (e->type == type && e->locale == loc && e->rules == rules) {
+         if (it != entries.begin()) {
+            entries.erase(it);
+            entries.push_front(e);
+         }
+         return e;
+      }
+   }
+
+   while (entries.size() >= STRI__BRKITER_CACHE_SIZE) {
+      Entry* e = entries.back();
+      entries.pop_back();
+      if (e->rbiterator) delete e->rbiterator;
+      if (e->uiterator) ubrk_close(e->uiterator);
+      delete e;
+   }
+
+   Entry* e = new Entry;
+   if (!e) throw StriException(MSG__MEM_ALLOC_ERROR);
+   e->type = type;
+   e->locale = loc;
+   e->rules = rules;
+   e->rbiterator = NULL;
+   e->uiterator = NULL;
+   e->asciiFastPath = false;
+   entries.push_front(e);
+   return e;
+}
+
+
+/** Get a new BreakIterator (C++ API)
+ *
+ * @param type break iterator type
+ * @param locale locale ID, NULL for the default one
+ * @param rules custom rules or an empty string
+ * @param asciiFastPath [out] may stri__brkiter_ascii_* be used
+ *    instead of the returned iterator on ASCII strings?
+ * @return a clone of the cached prototype, to be deleted by the caller
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    moved from StriRuleBasedBreakIterator::open()
+ */
+BreakIterator* StriBrkIterCache::openRuleBasedBreakIterator(UBreakIteratorType type,
+   const char* locale, const UnicodeString& rules, bool& asciiFastPath)
+{
+   Entry* e = getEntry(type, locale, rules);
+   if (!e->rbiterator) {
+      UErrorCode status = U_ZERO_ERROR;
+      BreakIterator* proto = NULL;
+      if (!rules.isEmpty()) {
+         UParseError parseErr;
+         proto = (BreakIterator*) new RuleBasedBreakIterator(
+            UnicodeString(rules), parseErr, status
+         );
+      }
+      else {
+         Locale loc = Locale::createFromName(locale);
+         switch (type) {
+         case UBRK_CHARACTER: // character
+            proto = (BreakIterator*)BreakIterator::createCharacterInstance(loc, status);
+            break;
+         case UBRK_LINE: // line_break
+            proto = (BreakIterator*)BreakIterator::createLineInstance(loc, status);
+            break;
+         case UBRK_SENTENCE: // sentence
+            proto = (BreakIterator*)BreakIterator::createSentenceInstance(loc, status);
+            break;
+         case UBRK_WORD: // word
+            proto = (BreakIterator*)BreakIterator::createWordInstance(loc, status);
+            break;
+         default:
+            throw StriException(MSG__INTERNAL_ERROR);
+         }
+      }
+      STRI__CHECKICUSTATUS_THROW(status, {if (proto) delete proto;})
+      e->rbiterator = proto;
+      e->asciiFastPath = rules.isEmpty() && stri__brkiter_ascii_check(proto, type);
+   }
+
+   asciiFastPath = e->asciiFastPath;
+   BreakIterator* ret = e->rbiterator->clone();
+   if (!ret) throw StriException(MSG__MEM_ALLOC_ERROR);
+   return ret;
+}
+
+
+/** Get a new UBreakIterator (C API)
+ *
+ * @param type break iterator type
+ * @param locale locale ID, NULL for the default one
+ * @param rules custom rules or an empty string
+ * @return a clone of the cached prototype, to be closed by the caller
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    moved from StriUBreakIterator::open()
+ */
+UBreakIterator* StriBrkIterCache::openUBreakIterator(UBreakIteratorType type,
+   const char* locale, const UnicodeString& rules)
+{
+   Entry* e = getEntry(type, locale, rules);
+   if (!e->uiterator) {
+      UErrorCode status = U_ZERO_ERROR;
+      UBreakIterator* proto = NULL;
+      if (!rules.isEmpty()) {
+         UParseError parseErr;
+         UnicodeString rules_copy(rules); // getTerminatedBuffer() is non-const
+         proto = ubrk_openRules(rules_copy.getTerminatedBuffer(),
+                                -1/*null-terminated*/, NULL, 0,
+                                &parseErr, &status);
+      }
+      else {
+         switch (type) {
+         case UBRK_CHARACTER: // character
+         case UBRK_LINE: // line_break
+         case UBRK_SENTENCE: // sentence
+         case UBRK_WORD: // word
+            proto = ubrk_open(type, locale, NULL, 0, &status);
+            break;
+         default:
+            throw StriException(MSG__INTERNAL_ERROR);
+         }
+      }
+      STRI__CHECKICUSTATUS_THROW(status, {if (proto) ubrk_close(proto);})
+      e->uiterator = proto;
+   }
+
+   UErrorCode status = U_ZERO_ERROR;
+#if U_ICU_VERSION_MAJOR_NUM >= 69
+   UBreakIterator* ret = ubrk_clone(e->uiterator, &status);
+#else
+   int32_t buffer_size = 1; // no stack buffer: always allocate
+   UBreakIterator* ret = ubrk_safeClone(e->uiterator, NULL, &buffer_size, &status);
+#endif
+   STRI__CHECKICUSTATUS_THROW(status, {if (ret) ubrk_close(ret);})
+   return ret;
+}
+
+
+/** Delete all the cached prototypes
+ *
+ * Called when the library is unloaded.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriBrkIterCache::clear()
+{
+   while (!entries.empty()) {
+      Entry* e = entries.back();
+      entries.pop_back();
+      if (e->rbiterator) delete e->rbiterator;
+      if (e->uiterator) ubrk_close(e->uiterator);
+      delete e;
+   }
+}
@@ -39,6 +39,56 @@
 #include <unicode/brkiter.h>
 #include <unicode/uloc.h>
 #include <unicode/locid.h>
+#include <string>
+
+
+/** maximal number of break iterator prototypes kept in StriBrkIterCache */
+#define STRI__BRKITER_CACHE_SIZE 16
+
+
+/**
+ * A process-wide cache of break iterator prototypes
+ *
+ * Creating a break iterator (loading the dictionaries, compiling
+ * the rules) is expensive; cloning an existing one is cheap.
+ * Prototypes are keyed by (type, locale, rules); at most
+ * STRI__BRKITER_CACHE_SIZE least recently used ones are kept.
+ *
+ * The skip-rule-status option is not a part of the key,
+ * as it does not affect the ICU objects (see
+ * StriRuleBasedBreakIterator::ignoreBoundary).
+ *
+ * Not thread-safe: to be used from R's main thread only.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriBrkIterCache {
+   private:
+
+      struct Entry {
+         UBreakIteratorType type;
+         std::string locale;     // "" for rule-based iterators
+         UnicodeString rules;
+         BreakIterator* rbiterator;  // C++ API prototype or NULL
+         UBreakIterator* uiterator;  // C API prototype or NULL
+         bool asciiFastPath;  // may rbiterator be replaced by stri__brkiter_ascii_*?
+      };
+
+      static std::deque<Entry*> entries; // most recently used first
+
+      static Entry* getEntry(UBreakIteratorType type, const char* locale,
+         const UnicodeString& rules);
+
+   public:
+
+      static BreakIterator* openRuleBasedBreakIterator(UBreakIteratorType type,
+         const char* locale, const UnicodeString& rules, bool& asciiFastPath);
+
+      static UBreakIterator* openUBreakIterator(UBreakIteratorType type,
+         const char* locale, const UnicodeString& rules);
+
+      static void clear();
+};
 
 
 /**
@@ -100,6 +150,8 @@ class StriBrkIterOptions {
  * @version 1.1.3 (Marek Gagolewski, 2017-01-07) UBRK_COUNT deprecated
  *
  * @version 1.1.6 (Marek Gagolewski, 2017-04-22) Add support for RBBI
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) clone cached prototypes
  */
 class StriUBreakIterator : public StriBrkIterOptions {
    private:
@@ -110,32 +162,7 @@ class StriUBreakIterator : public StriBrkIterOptions {
 #ifndef NDEBUG
          if (uiterator) throw StriException("!NDEBUG: StriUBreakIterator::open()");
 #endif
-         UErrorCode status = U_ZERO_ERROR;
-         if (!rules.isEmpty()) {
-            UParseError parseErr;
-            uiterator = ubrk_openRules(rules.getTerminatedBuffer(),
-                                       -1/*null-terminated*/, NULL, 0,
-                                       &parseErr, &status);
-         }
-         else {
-            switch (type) {
-            case UBRK_CHARACTER: // character
-               uiterator = ubrk_open(UBRK_CHARACTER, locale, NULL, 0, &status);
-               break;
-            case UBRK_LINE: // line_break
-               uiterator = ubrk_open(UBRK_LINE, locale, NULL, 0, &status);
-               break;
-            case UBRK_SENTENCE: // sentence
-               uiterator = ubrk_open(UBRK_SENTENCE, locale, NULL, 0, &status);
-               break;
-            case UBRK_WORD: // word
-               uiterator = ubrk_open(UBRK_WORD, locale, NULL, 0, &status);
-               break;
-            default:
-               throw StriException(MSG__INTERNAL_ERROR);
-            }
-         }
-         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+         uiterator = StriBrkIterCache::openUBreakIterator(type, locale, rules);
       }
 
 
@@ -194,6 +221,11 @@ class StriUBreakIterator : public StriBrkIterOptions {
  * separate class
  *
  * @version 1.1.6 (Marek Gagolewski, 2017-04-22) Add support for RBBI
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) clone cached prototypes
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) ASCII fast path
+ * for word and sentence boundaries
  */
 class StriRuleBasedBreakIterator : public StriBrkIterOptions {
    private:
@@ -204,42 +236,24 @@ class StriRuleBasedBreakIterator : public StriBrkIterOptions {
       const char* searchStr; // owned by caller
       R_len_t searchLen; // in bytes
 
+      bool asciiFastPath; // can ASCII strings be segmented without ICU?
+      bool asciiMode;     // is the current searchStr segmented without ICU?
+      std::vector< std::pair<R_len_t, int> > asciiBoundaries; // (position, rule status)
+      R_len_t asciiIndex; // current index in asciiBoundaries
+
       void setEmptyOpts() {
          rbiterator = NULL;
          searchText = NULL;
          searchPos = BreakIterator::DONE;
          searchStr = NULL;
          searchLen = 0;
+         asciiFastPath = false;
+         asciiMode = false;
+         asciiIndex = 0;
       }
 
       void open() {
-         UErrorCode status = U_ZERO_ERROR;
-         Locale loc = Locale::createFromName(locale);
-         if (!rules.isEmpty()) {
-            UParseError parseErr;
-            rbiterator = (BreakIterator*) new RuleBasedBreakIterator(
-               UnicodeString(rules), parseErr, status
-            );
-         }
-         else {
-            switch (type) {
-            case UBRK_CHARACTER: // character
-               rbiterator = (BreakIterator*)BreakIterator::createCharacterInstance(loc, status);
-               break;
-            case UBRK_LINE: // line_break
-               rbiterator = (BreakIterator*)BreakIterator::createLineInstance(loc, status);
-               break;
-            case UBRK_SENTENCE: // sentence
-               rbiterator = (BreakIterator*)BreakIterator::createSentenceInstance(loc, status);
-               break;
-            case UBRK_WORD: // word
-               rbiterator = (BreakIterator*)BreakIterator::createWordInstance(loc, status);
-               break;
-            default:
-               throw StriException(MSG__INTERNAL_ERROR);
-            }
-         }
-         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+         rbiterator = StriBrkIterCache::openRuleBasedBreakIterator(type, locale, rules, asciiFastPath);
       }
 
       bool ignoreBoundary();
@@ -277,6 +291,12 @@ class StriRuleBasedBreakIterator : public StriBrkIterOptions {
 
       void setupMatcher(const char* searchStr, R_len_t searchLen);
 
+      /** @return whether ASCII strings are segmented without ICU */
+      bool isAsciiFastPath() {
+         if (!rbiterator) open();
+         return asciiFastPath;
+      }
+
       void first();
       bool next();
       bool next(std::pair<R_len_t, R_len_t>& bdr);
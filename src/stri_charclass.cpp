@@ -0,0 +1,173 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "stri_stringi.h"
+#include "stri_charclass.h"
+
+
+/** maximal number of character classes kept in StriCharClassCache */
+#define STRI__CHARCLASS_CACHE_SIZE 32
+
+
+std::deque<StriCharClassCache::Entry*> StriCharClassCache::entries;
+
+
+/** Set the class from a UnicodeSet pattern
+ *
+ * @param pattern pattern, e.g., "\\p{L}" or "[a-z]"
+ * @param status ICU error code
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriCharClass::applyPattern(const UnicodeString& pattern, UErrorCode& status)
+{
+   m_set.applyPattern(pattern, status);
+   if (U_FAILURE(status)) return;
+   m_set.freeze();
+   buildBitmaps();
+}
+
+
+/** Build the lookup tables for the BMP
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriCharClass::buildBitmaps()
+{
+   std::vector<uint32_t> bits(0x10000>>5, 0);
+   int32_t nranges = m_set.getRangeCount();
+   for (int32_t r = 0; r < nranges; ++r) {
+      UChar32 c = m_set.getRangeStart(r);
+      UChar32 c_end = m_set.getRangeEnd(r);
+      if (c > 0xFFFF) break;
+      if (c_end > 0xFFFF) c_end = 0xFFFF;
+      while (c <= c_end) {
+         if ((c&31) == 0 && c+31 <= c_end) { // a whole word
+            bits[c>>5] = ~(uint32_t)0;
+            c += 32;
+         }
+         else {
+            bits[c>>5] |= (uint32_t)1<<(c&31);
+            ++c;
+         }
+      }
+   }
+
+   for (int k = 0; k < 4; ++k)
+      m_ascii[k] = bits[k];
+
+   m_rows.assign(16, 0);
+   for (int k = 8; k < 16; ++k)
+      m_rows[k] = ~(uint32_t)0;
+   for (int b = 0; b < 256; ++b) {
+      bool none = true, all = true;
+      for (int k = 0; k < 8; ++k) {
+         none = none && (bits[8*b+k] == 0);
+         all  = all  && (bits[8*b+k] == ~(uint32_t)0);
+      }
+      if (none)
+         m_bmp[b] = 0;
+      else if (all)
+         m_bmp[b] = 1;
+      else {
+         m_bmp[b] = (uint16_t)(m_rows.size()>>3);
+         m_rows.insert(m_rows.end(), bits.begin()+8*b, bits.begin()+8*(b+1));
+      }
+   }
+}
+
+
+/** Get a character class
+ *
+ * @param pattern UTF-8 pattern
+ * @param n number of bytes in pattern
+ * @param status ICU error code
+ * @return character class, owned by the cache; valid until the next call;
+ *    NULL on error
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+const StriCharClass* StriCharClassCache::get(const char* pattern, R_len_t n,
+   UErrorCode& status)
+{
+   for (std::deque<Entry*>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      Entry* e = *it;
+      if (e->pattern.size() == (size_t)n && !memcmp(e->pattern.data(), pattern, n)) {
+         if (it != entries.begin()) {
+            entries.erase(it);
+            entries.push_front(e);
+         }
+         return &e->cls;
+      }
+   }
+
+   Entry* e = new Entry;
+   if (!e) throw StriException(MSG__MEM_ALLOC_ERROR);
+   e->pattern.assign(pattern, n);
+   e->cls.applyPattern(UnicodeString::fromUTF8(StringPiece(pattern, n)), status);
+   if (U_FAILURE(status)) {
+      delete e;
+      return NULL;
+   }
+
+   while (entries.size() >= STRI__CHARCLASS_CACHE_SIZE) {
+      delete entries.back();
+      entries.pop_back();
+   }
+   entries.push_front(e);
+   return &e->cls;
+}
+
+
+/** Delete all the cached character classes
+ *
+ * Called when the library is unloaded.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriCharClassCache::clear()
+{
+   while (!entries.empty()) {
+      delete entries.back();
+      entries.pop_back();
+   }
+}
+
+
+/** Delete all the cached character classes (see StriCharClassCache)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__charclass_clear_cache()
+{
+   StriCharClassCache::clear();
+}
@@ -0,0 +1,127 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_charclass_h
+#define __stri_charclass_h
+
+#include "stri_stringi.h"
+#include <unicode/uniset.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+
+/**
+ * A frozen UnicodeSet with fast code point membership tests
+ *
+ * UnicodeSet::contains() performs a binary search over the set's
+ * ranges. Here, ASCII code points are looked up in a 128-bit bitmap,
+ * the remaining BMP ones in a two-level bitmap (256 blocks
+ * of 256 bits; all the blocks entirely in or entirely out of the set
+ * share a common row), and only the supplementary code points
+ * are passed to the UnicodeSet.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriCharClass {
+
+   private:
+
+      UnicodeSet m_set;
+      uint32_t m_ascii[4];          // code points 0..127
+      uint16_t m_bmp[256];          // row index for each 256-code point block
+      std::vector<uint32_t> m_rows; // rows of 8 words; row 0 = none, 1 = all
+
+      void buildBitmaps();
+
+   public:
+
+      StriCharClass() {
+         for (int k = 0; k < 4; ++k) m_ascii[k] = 0;
+         for (int k = 0; k < 256; ++k) m_bmp[k] = 0;
+      }
+
+      void applyPattern(const UnicodeString& pattern, UErrorCode& status);
+
+      void setToBogus() { m_set.setToBogus(); }
+
+      bool isBogus() const { return m_set.isBogus(); }
+
+      /** @return the underlying (frozen) set */
+      const UnicodeSet& getUnicodeSet() const { return m_set; }
+
+      /** Check if a code point belongs to the set
+       *
+       * @param c code point
+       * @return true if c is in the set (strings in the set are ignored)
+       */
+      inline bool contains(UChar32 c) const {
+         if ((uint32_t)c < 128)
+            return (m_ascii[c>>5] >> (c&31)) & 1;
+         else if ((uint32_t)c < 0x10000)
+            return (m_rows[((size_t)m_bmp[c>>8]<<3) | ((c>>5)&7)] >> (c&31)) & 1;
+         else
+            return m_set.contains(c);
+      }
+};
+
+
+/**
+ * A process-wide cache of character classes
+ *
+ * Parsing a pattern like \p{Wspace} and building the corresponding
+ * set is much more expensive than copying a frozen one,
+ * and most programs use just a few distinct patterns.
+ * Here we keep at most STRI__CHARCLASS_CACHE_SIZE recently used ones,
+ * keyed by pattern.
+ *
+ * Not thread-safe: to be used from R's main thread only.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriCharClassCache {
+   private:
+
+      struct Entry {
+         std::string pattern;
+         StriCharClass cls;
+      };
+
+      static std::deque<Entry*> entries; // most recently used first
+
+   public:
+
+      static const StriCharClass* get(const char* pattern, R_len_t n, UErrorCode& status);
+      static void clear();
+};
+
+#endif
@@ -0,0 +1,171 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_charsxp_memo_h
+#define __stri_charsxp_memo_h
+
+
+/**
+ * A hash table mapping CHARSXP pointers to indices
+ *
+ * R keeps a global cache of CHARSXPs, hence equal strings
+ * (in the same encoding) are usually represented by the very
+ * same pointer. This may be used to process each distinct string
+ * of a character vector only once.
+ *
+ * Open addressing with linear probing; the table grows
+ * so that it is at most half full.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriCharsxpMemo {
+
+   private:
+
+      std::vector<SEXP> m_keys;     ///< NULL denotes an empty slot
+      std::vector<R_len_t> m_vals;
+      size_t m_mask;                ///< table size - 1 (table size is a power of 2)
+      R_len_t m_count;              ///< number of keys stored
+
+
+      inline size_t hash(SEXP key) const {
+         // CHARSXPs are at least 8-byte aligned
+         size_t h = (size_t)key >> 3;
+         h ^= (h >> 16);
+         h *= (size_t)0x45d9f3bUL;
+         h ^= (h >> 16);
+         return h & m_mask;
+      }
+
+
+      void rehash(size_t newsize) {
+         std::vector<SEXP> old_keys(newsize, (SEXP)NULL);
+         std::vector<R_len_t> old_vals(newsize, -1);
+         old_keys.swap(m_keys);
+         old_vals.swap(m_vals);
+         m_mask = newsize-1;
+         for (size_t j=0; j<old_keys.size(); ++j) {
+            if (!old_keys[j]) continue;
+            size_t k = hash(old_keys[j]);
+            while (m_keys[k]) k = (k+1) & m_mask;
+            m_keys[k] = old_keys[j];
+            m_vals[k] = old_vals[j];
+         }
+      }
+
+
+   public:
+
+      /** constructor
+       *
+       * @param expected expected number of keys (memory is allocated lazily)
+       */
+      StriCharsxpMemo(R_len_t expected=0) {
+         m_mask = 0;
+         m_count = 0;
+         if (expected > 0) {
+            size_t size = 16;
+            while (size < 2*(size_t)expected) size *= 2;
+            rehash(size);
+         }
+      }
+
+
+      /** number of keys stored */
+      inline R_len_t size() const {
+         return m_count;
+      }
+
+
+      /** get the value associated with a key
+       *
+       * @param key CHARSXP
+       * @return value or -1 if not found
+       */
+      R_len_t find(SEXP key) const {
+         if (m_keys.empty()) return -1;
+         size_t k = hash(key);
+         while (m_keys[k]) {
+            if (m_keys[k] == key) return m_vals[k];
+            k = (k+1) & m_mask;
+         }
+         return -1;
+      }
+
+
+      /** associate a value with a key (overwrite if already present)
+       *
+       * @param key CHARSXP
+       * @param val nonnegative value
+       */
+      void assign(SEXP key, R_len_t val) {
+         if (2*((size_t)m_count+1) > m_keys.size())
+            rehash(m_keys.empty()?16:2*m_keys.size());
+
+         size_t k = hash(key);
+         while (m_keys[k]) {
+            if (m_keys[k] == key) {
+               m_vals[k] = val;
+               return;
+            }
+            k = (k+1) & m_mask;
+         }
+         m_keys[k] = key;
+         m_vals[k] = val;
+         ++m_count;
+      }
+
+
+      /** associate a value with a key (unless already present)
+       *
+       * @param key CHARSXP
+       * @param val nonnegative value
+       * @return value already associated with the key or
+       *    -1 if the key has just been inserted
+       */
+      R_len_t insert(SEXP key, R_len_t val) {
+         if (2*((size_t)m_count+1) > m_keys.size())
+            rehash(m_keys.empty()?16:2*m_keys.size());
+
+         size_t k = hash(key);
+         while (m_keys[k]) {
+            if (m_keys[k] == key) return m_vals[k];
+            k = (k+1) & m_mask;
+         }
+         m_keys[k] = key;
+         m_vals[k] = val;
+         ++m_count;
+         return -1;
+      }
+};
+
+#endif
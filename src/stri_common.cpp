@@ -31,9 +31,16 @@
 
 
 #include "stri_stringi.h"
+#include "stri_charsxp_memo.h"
 #include <vector>
 
 
+/* see stri__unique_strings() */
+#define STRI__UNIQUE_MIN_LENGTH 16384
+#define STRI__UNIQUE_PROBE_SIZE 4096
+#define STRI__UNIQUE_PROBE_MAXDISTINCT (STRI__UNIQUE_PROBE_SIZE/4)
+
+
 /**
  *  Set names attribute for an R object
  *
@@ -326,3 +333,128 @@ int stri__match_arg(const char* option, const char** set) {
    }
    return which;
 }
+
+
+/** Find distinct CHARSXPs in a character vector, if it is worth it
+ *
+ * R keeps a global cache of CHARSXPs, hence equal strings (in the same
+ * encoding) are represented by the very same pointer. Vectors originating
+ * from factors, joins etc. often consist of very few distinct strings.
+ * For them, a pure per-element transform may be computed
+ * on distinct strings only, see STRI__UNIQUE_DISPATCH.
+ *
+ * A cheap probe is performed first: STRI__UNIQUE_PROBE_SIZE
+ * evenly spaced elements are examined and the procedure gives up
+ * if there are too many distinct strings among them.
+ *
+ * @param str character vector
+ * @param trivial_ascii give up if all the probed strings are in ASCII
+ *    (for functions that do not need to look at ASCII strings at all)
+ * @return \code{R_NilValue} if it is not worth it; otherwise a list with
+ *    2 elements: a character vector of distinct strings and an integer vector
+ *    giving for each string in \code{str} the 0-based index
+ *    of its counterpart in the former
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri__unique_strings(SEXP str, bool trivial_ascii)
+{
+   R_len_t str_n = LENGTH(str);
+   if (str_n < STRI__UNIQUE_MIN_LENGTH)
+      return R_NilValue;
+
+   R_len_t step = str_n/STRI__UNIQUE_PROBE_SIZE;
+   bool all_ascii = true;
+   StriCharsxpMemo probe(STRI__UNIQUE_PROBE_SIZE);
+   for (R_len_t k=0; k<STRI__UNIQUE_PROBE_SIZE; ++k) {
+      SEXP curs = STRING_ELT(str, k*step);
+      if (curs != NA_STRING && !IS_ASCII(curs))
+         all_ascii = false;
+      probe.insert(curs, k);
+      if (probe.size() > STRI__UNIQUE_PROBE_MAXDISTINCT)
+         return R_NilValue;
+   }
+
+   if (trivial_ascii && all_ascii)
+      return R_NilValue;
+
+   std::vector<SEXP> distinct;
+   distinct.reserve(4*(size_t)probe.size());
+   StriCharsxpMemo index_map(4*probe.size());
+
+   SEXP ret, index, str_unique;
+   PROTECT(index = Rf_allocVector(INTSXP, str_n));
+   int* index_tab = INTEGER(index);
+   for (R_len_t i=0; i<str_n; ++i) {
+      SEXP curs = STRING_ELT(str, i);
+      R_len_t j = index_map.insert(curs, (R_len_t)distinct.size());
+      if (j < 0) {
+         j = (R_len_t)distinct.size();
+         distinct.push_back(curs);
+      }
+      index_tab[i] = j;
+   }
+
+   R_len_t distinct_n = (R_len_t)distinct.size();
+   PROTECT(str_unique = Rf_allocVector(STRSXP, distinct_n));
+   for (R_len_t j=0; j<distinct_n; ++j)
+      SET_STRING_ELT(str_unique, j, distinct[j]);
+
+   PROTECT(ret = Rf_allocVector(VECSXP, 2));
+   SET_VECTOR_ELT(ret, 0, str_unique);
+   SET_VECTOR_ELT(ret, 1, index);
+   UNPROTECT(3);
+   return ret;
+}
+
+
+/** Scatter the results computed on distinct strings
+ *
+ * @param ret_unique character, integer, logical or numeric vector
+ *    (results for each distinct string)
+ * @param index integer vector of 0-based indices into \code{ret_unique},
+ *    see stri__unique_strings()
+ * @return vector of the same type as \code{ret_unique}
+ *    and length of \code{index}
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri__unique_expand(SEXP ret_unique, SEXP index)
+{
+   R_len_t index_n = LENGTH(index);
+   const int* index_tab = INTEGER(index);
+
+   SEXP ret;
+   PROTECT(ret = Rf_allocVector(TYPEOF(ret_unique), index_n));
+   switch (TYPEOF(ret_unique)) {
+      case STRSXP:
+         for (R_len_t i=0; i<index_n; ++i)
+            SET_STRING_ELT(ret, i, STRING_ELT(ret_unique, index_tab[i]));
+         break;
+
+      case INTSXP:
+      case LGLSXP: {
+         const int* ret_unique_tab = (TYPEOF(ret_unique) == INTSXP)
+            ?INTEGER(ret_unique):LOGICAL(ret_unique);
+         int* ret_tab = (TYPEOF(ret_unique) == INTSXP)?INTEGER(ret):LOGICAL(ret);
+         for (R_len_t i=0; i<index_n; ++i)
+            ret_tab[i] = ret_unique_tab[index_tab[i]];
+         break;
+      }
+
+      case REALSXP: {
+         const double* ret_unique_tab = REAL(ret_unique);
+         double* ret_tab = REAL(ret);
+         for (R_len_t i=0; i<index_n; ++i)
+            ret_tab[i] = ret_unique_tab[index_tab[i]];
+         break;
+      }
+
+      default:
+         UNPROTECT(1);
+         Rf_error(MSG__INTERNAL_ERROR);
+   }
+
+   UNPROTECT(1);
+   return ret;
+}
@@ -35,7 +35,7 @@
 
 #include "stri_container_base.h"
 #include "stri_container_utf8.h"
-#include <unicode/uniset.h>
+#include "stri_charclass.h"
 
 
 /**
@@ -49,12 +49,16 @@
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-02)
  *          New method: locateAll
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          Use StriCharClass (bitmap-based membership tests)
+ *          and StriCharClassCache
  */
 class StriContainerCharClass : public StriContainerBase {
 
    private:
 
-      UnicodeSet* data; // array
+      StriCharClass* data; // array
 
    public:
 
@@ -75,16 +79,16 @@ class StriContainerCharClass : public StriContainerBase {
          this->data = NULL;
          if (_n > 0) {
             StriContainerUTF8 rvec_cont(rvec, _n, true);
-            this->data = new UnicodeSet[_n];
+            this->data = new StriCharClass[_n];
             for (int i=0; i<_n; ++i) {
                if (rvec_cont.isNA(i))
                   this->data[i].setToBogus();
                else {
                   UErrorCode status = U_ZERO_ERROR;
-                  this->data[i].applyPattern(
-                     UnicodeString::fromUTF8(rvec_cont.get(i).c_str()), status);
+                  const StriCharClass* cls = StriCharClassCache::get(
+                     rvec_cont.get(i).c_str(), rvec_cont.get(i).length(), status);
                   STRI__CHECKICUSTATUS_THROW(status, {delete [] data; data = NULL;})
-                  this->data[i].freeze();
+                  this->data[i] = *cls; // a copy: cls may be evicted by the next get()
                }
             }
          }
@@ -94,7 +98,7 @@ class StriContainerCharClass : public StriContainerBase {
          :StriContainerBase((StriContainerBase&)container)
       {
          if (container.data) {
-            this->data = new UnicodeSet[container.n];
+            this->data = new StriCharClass[container.n];
             for (int i=0; i<container.n; ++i)
                this->data[i] = container.data[i];
          }
@@ -111,7 +115,7 @@ class StriContainerCharClass : public StriContainerBase {
          this->~StriContainerCharClass();
          (StriContainerBase&) (*this) = (StriContainerBase&)container;
          if (container.data) {
-            this->data = new UnicodeSet[container.n];
+            this->data = new StriCharClass[container.n];
             for (int i=0; i<container.n; ++i)
                this->data[i] = container.data[i];
          }
@@ -136,9 +140,9 @@ class StriContainerCharClass : public StriContainerBase {
 
       /** get the vectorized ith element
        * @param i index
-       * @return integer
+       * @return character class
        */
-      inline const UnicodeSet& get(R_len_t i) const {
+      inline const StriCharClass& get(R_len_t i) const {
 #ifndef NDEBUG
          if (i < 0 || i >= nrecycle)
             throw StriException("StriContainerCharClass::get(): INDEX OUT OF BOUNDS");
@@ -155,7 +159,7 @@ class StriContainerCharClass : public StriContainerBase {
        * or total number of codepoints matched (idx_codepoint==true)
        */
       static R_len_t locateAll(deque< pair<R_len_t, R_len_t> >& occurrences,
-            const UnicodeSet* pattern_cur,
+            const StriCharClass* pattern_cur,
             const char* str_cur_s, R_len_t str_cur_n,
             bool merge_cur, bool idx_codepoint)
       {
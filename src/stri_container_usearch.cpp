@@ -52,9 +52,12 @@ StriContainerUStringSearch::StriContainerUStringSearch()
  * @param rstr R character vector
  * @param nrecycle extend length [vectorization]
  * @param col Collator; owned by external caller
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    no lazy conversion: UStringSearch does not copy the pattern
  */
 StriContainerUStringSearch::StriContainerUStringSearch(SEXP rstr, R_len_t _nrecycle, UCollator* _col)
-   : StriContainerUTF16(rstr, _nrecycle, true)
+   : StriContainerUTF16(rstr, _nrecycle, true, false/*lazy*/)
 {
    this->lastMatcherIndex = -1;
    this->lastMatcher = NULL;
@@ -34,6 +34,7 @@
 #include "stri_container_utf16.h"
 #include "stri_string8buf.h"
 #include "stri_ucnv.h"
+#include "stri_charsxp_memo.h"
 
 
 /**
@@ -44,6 +45,9 @@ StriContainerUTF16::StriContainerUTF16()
    : StriContainerBase()
 {
    this->str = NULL;
+   this->lazyIndex = NULL;
+   this->lazyWindow = 0;
+   this->lazyConverted = NULL;
 }
 
 
@@ -56,6 +60,9 @@ StriContainerUTF16::StriContainerUTF16()
 StriContainerUTF16::StriContainerUTF16(R_len_t _nrecycle)
 {
    this->str = NULL;
+   this->lazyIndex = NULL;
+   this->lazyWindow = 0;
+   this->lazyConverted = NULL;
    this->init_Base(_nrecycle, _nrecycle, false);
    if (this->n > 0) {
       this->str = new UnicodeString[this->n];
@@ -67,116 +74,217 @@ StriContainerUTF16::StriContainerUTF16(R_len_t _nrecycle)
 /**
  * Construct String Container from an R character vector
  *
+ * Read-only containers (\code{shallowrecycle==true}) do not convert
+ * anything here by default: each string is converted on first \code{get()},
+ * see \code{getLazy()}.
+ *
  * @param rstr R character vector
  * @param nrecycle extend length [vectorization]
  * @param shallowrecycle will \code{this->str} be ever modified?
+ * @param lazy convert strings on demand (read-only containers only);
+ *    set to \code{false} if the buffers returned by \code{get()}
+ *    must stay valid for the whole container's lifetime
  *
  * @version 1.0.6 (Marek Gagolewski, 2017-05-25)
  *    #270 latin-1 is windows-1252 on Windows
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    lazy conversion for read-only containers;
+ *    per-string conversion moved to convert();
+ *    each distinct latin-1/native CHARSXP is re-encoded only once
  */
-StriContainerUTF16::StriContainerUTF16(SEXP rstr, R_len_t _nrecycle, bool _shallowrecycle)
+StriContainerUTF16::StriContainerUTF16(SEXP rstr, R_len_t _nrecycle, bool _shallowrecycle, bool _lazy)
+   : ucnvASCII("US-ASCII"),
+#if defined(_WIN32) || defined(_WIN64)
+   // #270: latin-1 is windows-1252 on Windows
+     ucnvLatin1("WINDOWS-1252"),
+#else
+     ucnvLatin1("ISO-8859-1"),
+#endif
+     ucnvNative(NULL)
 {
+   /* Important: ICU provides full internationalization functionality
+   without any conversion table data. The common library contains
+   code to handle several important encodings algorithmically: US-ASCII,
+   ISO-8859-1, UTF-7/8/16/32, SCSU, BOCU-1, CESU-8, and IMAP-mailbox-name */
+
    this->str = NULL;
+   this->lazyIndex = NULL;
+   this->lazyWindow = 0;
+   this->lazyConverted = NULL;
 #ifndef NDEBUG
    if (!isString(rstr))
       throw StriException("DEBUG: !isString in StriContainerUTF16::StriContainerUTF16(SEXP rstr)");
 #endif
    R_len_t nrstr = LENGTH(rstr);
-   this->init_Base(nrstr, _nrecycle, _shallowrecycle); // calling LENGTH(rstr) fails on constructor call
+   this->init_Base(nrstr, _nrecycle, _shallowrecycle, rstr); // calling LENGTH(rstr) fails on constructor call
 
    if (this->n == 0)
       return; /* nothing more to do */
 
+   if (_shallowrecycle && _lazy) {
+      // read-only => convert lazily
+      // "bytes" are not allowed -- report this as early as in the eager mode
+      for (R_len_t i=0; i<nrstr; ++i) {
+         SEXP curs = STRING_ELT(rstr, i);
+         if (curs != NA_STRING && IS_BYTES(curs))
+            throw StriException(MSG__BYTESENC);
+      }
+
+      this->lazyWindow = (this->n < STRI__CONTAINER_UTF16_LAZY_WINDOW)
+         ?this->n:STRI__CONTAINER_UTF16_LAZY_WINDOW;
+      this->str = new UnicodeString[this->lazyWindow];
+      if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
+      this->lazyIndex = new R_len_t[this->lazyWindow];
+      if (!this->lazyIndex) throw StriException(MSG__MEM_ALLOC_ERROR);
+      for (R_len_t k=0; k<this->lazyWindow; ++k)
+         this->lazyIndex[k] = -1;
+      return;
+   }
+
    this->str = new UnicodeString[this->n];
    if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
    for (R_len_t i=0; i<this->n; ++i)
       this->str[i].setToBogus(); // in case it fails during conversion (this is NA)
 
-   /* Important: ICU provides full internationalization functionality
-   without any conversion table data. The common library contains
-   code to handle several important encodings algorithmically: US-ASCII,
-   ISO-8859-1, UTF-7/8/16/32, SCSU, BOCU-1, CESU-8, and IMAP-mailbox-name */
-   StriUcnv ucnvASCII("US-ASCII");
-#if defined(_WIN32) || defined(_WIN64)
-   // #270: latin-1 is windows-1252 on Windows
-   StriUcnv ucnvLatin1("WINDOWS-1252");
-#else
-   StriUcnv ucnvLatin1("ISO-8859-1");
-#endif
-   StriUcnv ucnvNative(NULL);
-
+   StriCharsxpMemo converted; // CHARSXP -> index of its re-encoded copy
    for (R_len_t i=0; i<nrstr; ++i) {
       SEXP curs = STRING_ELT(rstr, i);
       if (curs == NA_STRING) {
          continue; // keep NA
       }
 
-      if (IS_ASCII(curs)) {
-         // Version 1:
-         UConverter* ucnv = ucnvASCII.getConverter();
-         UErrorCode status = U_ZERO_ERROR;
-         this->str[i].setTo(
-            UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
-         );
-         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      if (!IS_ASCII(curs) && !IS_UTF8(curs)) {
+         // latin-1/native: the same CHARSXP may occur many times
+         // (factors, joins etc.) - re-encode it only once
+         R_len_t prev = converted.insert(curs, i);
+         if (prev >= 0) {
+            this->str[i].setTo(this->str[prev]); // shares the ref-counted buffer
+            continue;
+         }
+      }
 
-         // Performance improvement attempt #1:
-         // this->str[i] = new UnicodeString(UnicodeString::fromUTF8(CHAR(curs)));
-         // if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
-         // slower than the above
-
-         // Performance improvement attempt #2:
-         // Create UChar buf with LENGTH(curs) items, fill it with (CHAR(curs)[i], 0x00), i=1,...
-         // This wasn't faster than the ucnvASCII approach.
-
-         // Performance improvement attempt #3:
-         // slightly slower than ucnvASCII
-         // R_len_t curs_n = LENGTH(curs);
-         // const char* curs_s = CHAR(curs);
-         // this->str[i].remove(); // unset bogus (NA)
-         // UChar* buf = this->str[i].getBuffer(curs_n);
-         // for (R_len_t k=0; k<curs_n; ++k)
-         //   buf[k] = (UChar)curs_s[k]; // well, this is ASCII :)
-         // this->str[i].releaseBuffer(curs_n);
+      convert(curs, this->str[i]);
+   }
+
+   if (!_shallowrecycle) {
+      for (R_len_t i=nrstr; i<this->n; ++i) {
+         this->str[i].setTo(str[i%nrstr]);
       }
-      else if (IS_UTF8(curs)) {
-         // using ucnvUTF8 is slower for UTF-8
-         // the same is done for native encoding && ucnvNative_isUTF8
-         this->str[i].setTo(UnicodeString::fromUTF8(CHAR(curs)));
+   }
+}
+
+
+/** Convert a single (non-NA) CHARSXP to UTF-16
+ *
+ * @param curs CHARSXP
+ * @param out [out] destination
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    separated from the SEXP-constructor
+ */
+void StriContainerUTF16::convert(SEXP curs, UnicodeString& out) const
+{
+   if (IS_ASCII(curs)) {
+      // Version 1:
+      UConverter* ucnv = ucnvASCII.getConverter();
+      UErrorCode status = U_ZERO_ERROR;
+      out.setTo(
+         UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
+      );
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+      // Performance improvement attempt #1:
+      // this->str[i] = new UnicodeString(UnicodeString::fromUTF8(CHAR(curs)));
+      // if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
+      // slower than the above
+
+      // Performance improvement attempt #2:
+      // Create UChar buf with LENGTH(curs) items, fill it with (CHAR(curs)[i], 0x00), i=1,...
+      // This wasn't faster than the ucnvASCII approach.
+
+      // Performance improvement attempt #3:
+      // slightly slower than ucnvASCII
+      // R_len_t curs_n = LENGTH(curs);
+      // const char* curs_s = CHAR(curs);
+      // this->str[i].remove(); // unset bogus (NA)
+      // UChar* buf = this->str[i].getBuffer(curs_n);
+      // for (R_len_t k=0; k<curs_n; ++k)
+      //   buf[k] = (UChar)curs_s[k]; // well, this is ASCII :)
+      // this->str[i].releaseBuffer(curs_n);
+   }
+   else if (IS_UTF8(curs)) {
+      // using ucnvUTF8 is slower for UTF-8
+      // the same is done for native encoding && ucnvNative_isUTF8
+      out.setTo(UnicodeString::fromUTF8(CHAR(curs)));
+   }
+   else if (IS_LATIN1(curs)) {
+      UConverter* ucnv = ucnvLatin1.getConverter();
+      UErrorCode status = U_ZERO_ERROR;
+      out.setTo(
+         UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
+      );
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+   }
+   else if (IS_BYTES(curs)) {
+      throw StriException(MSG__BYTESENC);
+   }
+   else {
+      // an "unknown" (native) encoding may be set to UTF-8 (speedup)
+      if (ucnvNative.isUTF8()) {
+         // UTF-8
+         out.setTo(UnicodeString::fromUTF8(CHAR(curs)));
       }
-      else if (IS_LATIN1(curs)) {
-         UConverter* ucnv = ucnvLatin1.getConverter();
+      else {
+         UConverter* ucnv = ucnvNative.getConverter();
          UErrorCode status = U_ZERO_ERROR;
-         this->str[i].setTo(
+         out.setTo(
             UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
          );
          STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
       }
-      else if (IS_BYTES(curs)) {
-         throw StriException(MSG__BYTESENC);
-      }
-      else {
-         // an "unknown" (native) encoding may be set to UTF-8 (speedup)
-         if (ucnvNative.isUTF8()) {
-            // UTF-8
-            this->str[i].setTo(UnicodeString::fromUTF8(CHAR(curs)));
-         }
-         else {
-            UConverter* ucnv = ucnvNative.getConverter();
-            UErrorCode status = U_ZERO_ERROR;
-            this->str[i].setTo(
-               UnicodeString((const char*)CHAR(curs), (int32_t)LENGTH(curs), ucnv, status)
-            );
-            STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-         }
-      }
    }
+}
 
-   if (!_shallowrecycle) {
-      for (R_len_t i=nrstr; i<this->n; ++i) {
-         this->str[i].setTo(str[i%nrstr]);
+
+/** Convert the jth string into its window slot (lazy mode)
+ *
+ * The returned reference stays valid until a string that maps
+ * to the same slot (\code{j \% lazyWindow}) is requested.
+ *
+ * Latin-1/native strings still available in the window
+ * are not re-encoded.
+ *
+ * @param j index, \code{0 <= j < n}
+ * @return string
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+const UnicodeString& StriContainerUTF16::getLazy(R_len_t j) const
+{
+   R_len_t k = j%lazyWindow;
+   SEXP curs = STRING_ELT(sexp, j);
+
+   if (!IS_ASCII(curs) && !IS_UTF8(curs)) {
+      // latin-1/native: is this CHARSXP still in the window?
+      if (!lazyConverted) {
+         lazyConverted = new StriCharsxpMemo();
+         if (!lazyConverted) throw StriException(MSG__MEM_ALLOC_ERROR);
+      }
+      R_len_t s = lazyConverted->find(curs);
+      if (s >= 0 && lazyIndex[s] >= 0 && STRING_ELT(sexp, lazyIndex[s]) == curs) {
+         if (s != k)
+            str[k].setTo(str[s]); // shares the ref-counted buffer
+         lazyIndex[k] = j;
+         return str[k];
       }
+      lazyConverted->assign(curs, k);
    }
+
+   lazyIndex[k] = -1; // in case it fails during conversion
+   convert(curs, str[k]);
+   lazyIndex[k] = j;
+   return str[k];
 }
 
 
@@ -185,14 +293,27 @@ StriContainerUTF16::StriContainerUTF16(SEXP rstr, R_len_t _nrecycle, bool _shall
  *  @param container source
  */
 StriContainerUTF16::StriContainerUTF16(StriContainerUTF16& container)
-   :    StriContainerBase((StriContainerBase&)container)
+   :    StriContainerBase((StriContainerBase&)container),
+        ucnvASCII(container.ucnvASCII),
+        ucnvLatin1(container.ucnvLatin1),
+        ucnvNative(container.ucnvNative)
 {
+   this->lazyIndex = NULL;
+   this->lazyWindow = container.lazyWindow;
+   this->lazyConverted = NULL;
    if (container.str) {
-      this->str = new UnicodeString[this->n];
+      R_len_t nstr = (container.lazyIndex)?this->lazyWindow:this->n;
+      this->str = new UnicodeString[nstr];
       if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
-      for (int i=0; i<this->n; ++i) {
+      for (int i=0; i<nstr; ++i) {
          this->str[i].setTo(container.str[i]);
       }
+      if (container.lazyIndex) {
+         this->lazyIndex = new R_len_t[nstr];
+         if (!this->lazyIndex) throw StriException(MSG__MEM_ALLOC_ERROR);
+         for (int i=0; i<nstr; ++i)
+            this->lazyIndex[i] = container.lazyIndex[i];
+      }
    }
    else {
       this->str = NULL;
@@ -208,13 +329,26 @@ StriContainerUTF16& StriContainerUTF16::operator=(StriContainerUTF16& container)
 {
    this->~StriContainerUTF16();
    (StriContainerBase&) (*this) = (StriContainerBase&)container;
+   this->ucnvASCII = container.ucnvASCII;
+   this->ucnvLatin1 = container.ucnvLatin1;
+   this->ucnvNative = container.ucnvNative;
 
+   this->lazyIndex = NULL;
+   this->lazyWindow = container.lazyWindow;
+   this->lazyConverted = NULL;
    if (container.str) {
-      this->str = new UnicodeString[this->n];
+      R_len_t nstr = (container.lazyIndex)?this->lazyWindow:this->n;
+      this->str = new UnicodeString[nstr];
       if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
-      for (int i=0; i<this->n; ++i) {
+      for (int i=0; i<nstr; ++i) {
          this->str[i].setTo(container.str[i]);
       }
+      if (container.lazyIndex) {
+         this->lazyIndex = new R_len_t[nstr];
+         if (!this->lazyIndex) throw StriException(MSG__MEM_ALLOC_ERROR);
+         for (int i=0; i<nstr; ++i)
+            this->lazyIndex[i] = container.lazyIndex[i];
+      }
    }
    else {
       this->str = NULL;
@@ -232,6 +366,14 @@ StriContainerUTF16::~StriContainerUTF16()
       delete [] str;
       str = NULL;
    }
+   if (lazyIndex) {
+      delete [] lazyIndex;
+      lazyIndex = NULL;
+   }
+   if (lazyConverted) {
+      delete lazyConverted;
+      lazyConverted = NULL;
+   }
 }
 
 
@@ -246,21 +388,15 @@ StriContainerUTF16::~StriContainerUTF16()
  * @version 0.2-1 (Marek Gagolewski, 2014-03-23)
  *          using 1 tmpbuf + u_strToUTF8 for slightly better performance
  *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          grow tmpbuf on demand (no separate pass over all the strings,
+ *          which would convert each string twice in the lazy mode)
+ *
  * @return STRSXP
  */
 SEXP StriContainerUTF16::toR() const
 {
    R_len_t outbufsize = 0;
-   for (R_len_t i=0; i<nrecycle; ++i) {
-      if (!str[i%n].isBogus()) {
-         R_len_t thissize = str[i%n].length();
-         if (thissize > outbufsize)
-            outbufsize = thissize;
-      }
-   }
-   // One UChar -- <= U+FFFF  -> 1-3 bytes UTF8
-   // Two UChars -- >=U+10000 ->   4 bytes UTF8
-   outbufsize = UCNV_GET_MAX_BYTES_FOR_STRING(outbufsize, 3);
    String8buf outbuf(outbufsize);
 
    SEXP ret;
@@ -268,12 +404,21 @@ SEXP StriContainerUTF16::toR() const
 
    UErrorCode status = U_ZERO_ERROR;
    for (R_len_t i=0; i<nrecycle; ++i) {
-      if (str[i%n].isBogus())
+      if (isNA(i))
          SET_STRING_ELT(ret, i, NA_STRING);
       else {
+         const UnicodeString& curs = get(i);
+         // One UChar -- <= U+FFFF  -> 1-3 bytes UTF8
+         // Two UChars -- >=U+10000 ->   4 bytes UTF8
+         R_len_t thissize = UCNV_GET_MAX_BYTES_FOR_STRING(curs.length(), 3);
+         if (thissize > outbufsize) {
+            outbufsize = thissize;
+            outbuf.resize(outbufsize, false);
+         }
+
          int outrealsize = 0;
          u_strToUTF8(outbuf.data(), outbufsize, &outrealsize,
-            str[i%n].getBuffer(), str[i%n].length(), &status);
+            curs.getBuffer(), curs.length(), &status);
          STRI__CHECKICUSTATUS_THROW(status, {UNPROTECT(1);})
          SET_STRING_ELT(ret, i,
             Rf_mkCharLenCE(outbuf.data(), outrealsize, (cetype_t)CE_UTF8));
@@ -299,11 +444,11 @@ SEXP StriContainerUTF16::toR(R_len_t i) const
       throw StriException("StriContainerUTF16::toR(): INDEX OUT OF BOUNDS");
 #endif
 
-   if (str[i%n].isBogus())
+   if (isNA(i))
       return NA_STRING;
    else {
       std::string s;
-      str[i%n].toUTF8String(s);
+      get(i).toUTF8String(s);
       return Rf_mkCharLenCE(s.c_str(), (int)s.length(), (cetype_t)CE_UTF8);
    }
 }
@@ -34,6 +34,14 @@
 #define __stri_container_utf16_h
 
 #include "stri_container_base.h"
+#include "stri_ucnv.h"
+#include "stri_charsxp_memo.h"
+
+
+/** maximal number of converted strings kept by a read-only
+ *  (lazily converting) StriContainerUTF16
+ */
+#define STRI__CONTAINER_UTF16_LAZY_WINDOW 64
 
 /**
  * A class to handle conversion between R character vectors
@@ -55,19 +63,34 @@
  *          UnicodeString::fromUTF8 (for speedup);
  *          str now is UnicodeString*, and not UnicodeString**;
  *          using UnicodeString::isBogus to represent NA
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          read-only containers convert strings lazily, on first get(),
+ *          keeping at most STRI__CONTAINER_UTF16_LAZY_WINDOW
+ *          UnicodeStrings at a time (a direct-mapped window);
+ *          repeated latin-1/native CHARSXPs are re-encoded only once
  */
 class StriContainerUTF16 : public StriContainerBase {
 
    protected:
 
-      UnicodeString* str;       ///< data - \code{UnicodeString}s
+      UnicodeString* str;       ///< data - \code{UnicodeString}s (or the lazy window)
+      R_len_t* lazyIndex;       ///< lazy mode only: index of the string stored in each window slot (-1 if none)
+      R_len_t lazyWindow;       ///< lazy mode only: window size
+      mutable StriUcnv ucnvASCII;
+      mutable StriUcnv ucnvLatin1;
+      mutable StriUcnv ucnvNative;
+      mutable StriCharsxpMemo* lazyConverted; ///< lazy mode only: re-encoded CHARSXP -> window slot (created on demand)
+
+      void convert(SEXP curs, UnicodeString& out) const;
+      const UnicodeString& getLazy(R_len_t j) const;
 
 
    public:
 
       StriContainerUTF16();
       StriContainerUTF16(R_len_t nrecycle);
-      StriContainerUTF16(SEXP rstr, R_len_t nrecycle, bool shallowrecycle=true);
+      StriContainerUTF16(SEXP rstr, R_len_t nrecycle, bool shallowrecycle=true, bool lazy=true);
       StriContainerUTF16(StriContainerUTF16& container);
       ~StriContainerUTF16();
       StriContainerUTF16& operator=(StriContainerUTF16& container);
@@ -86,6 +109,8 @@ class StriContainerUTF16 : public StriContainerBase {
          if (i < 0 || i >= nrecycle)
             throw StriException("StriContainerUTF16::isNA(): INDEX OUT OF BOUNDS");
 #endif
+         if (lazyIndex)
+            return (STRING_ELT(sexp, i%n) == NA_STRING);
          return str[i%n].isBogus();
       }
 
@@ -99,6 +124,12 @@ class StriContainerUTF16 : public StriContainerBase {
          if (isNA(i))
             throw StriException("StriContainerUTF16::get(): isNA");
 #endif
+         if (lazyIndex) {
+            R_len_t j = i%n;
+            if (lazyIndex[j%lazyWindow] != j)
+               return getLazy(j);
+            return str[j%lazyWindow];
+         }
          return str[i%n];
       }
 
@@ -34,6 +34,7 @@
 #include "stri_container_utf8.h"
 #include "stri_ucnv.h"
 #include "stri_string8buf.h"
+#include "stri_charsxp_memo.h"
 
 /**
  * Default constructor
@@ -43,6 +44,9 @@ StriContainerUTF8::StriContainerUTF8()
    : StriContainerBase()
 {
    str = NULL;
+   arena = NULL;
+   passarena[0] = passarena[1] = NULL;
+   passcur = -1;
 }
 
 
@@ -55,10 +59,19 @@ StriContainerUTF8::StriContainerUTF8()
  *
  * @version 1.0.6 (Marek Gagolewski, 2017-05-25)
  *    #270 latin-1 is windows-1252 on Windows
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    each distinct latin-1/native CHARSXP is re-encoded only once
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    deep copies are stored in an arena
  */
 StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallowrecycle)
 {
    this->str = NULL;
+   this->arena = NULL;
+   this->passarena[0] = this->passarena[1] = NULL;
+   this->passcur = -1;
 
 #ifndef NDEBUG
    if (!isString(rstr))
@@ -88,6 +101,7 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
    StriUcnv ucnvNative(NULL);
    R_len_t outbufsize = -1;
    String8buf outbuf(0);
+   StriCharsxpMemo converted; // CHARSXP -> index of its re-encoded copy
 //      int    tmpbufsize = -1;
 //      UChar* tmpbuf = NULL;
 
@@ -104,7 +118,8 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
       }
       else if (IS_UTF8(curs)) {
          // UTF-8 - ultra fast
-         this->str[i].initialize(CHAR(curs), LENGTH(curs), false/*!_shallowrecycle*/, true/*killbom*/, false/*isASCII*/);
+         this->str[i].initialize(CHAR(curs), LENGTH(curs), false/*!_shallowrecycle*/, true/*killbom*/, false/*isASCII*/,
+            getArena()/*used only if there's a BOM*/);
          // the same is done for native encoding && ucnvNative_isUTF8
          // @TODO: use macro (here & ucnvNative_isUTF8 below)
       }
@@ -126,13 +141,25 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
                // UTF-8 - ultra fast
                // @TODO: use macro
                this->str[i].initialize(CHAR(curs), LENGTH(curs),
-                  false /*!_shallowrecycle*/, true/*killbom*/, false/*isASCII*/);
+                  false /*!_shallowrecycle*/, true/*killbom*/, false/*isASCII*/,
+                  getArena()/*used only if there's a BOM*/);
                continue;
             }
 
             ucnvCurrent = ucnvNative.getConverter();
          }
 
+         R_len_t prev = converted.insert(curs, i);
+         if (prev >= 0) {
+            // this very CHARSXP has already been re-encoded
+            // (factors, joins etc. - the same string may occur many times)
+            const String8& prev_str = this->str[prev];
+            this->str[i].initialize(prev_str.c_str(), prev_str.length(),
+               !_shallowrecycle/*memalloc; a read-only copy may share the buffer*/,
+               false/*killbom*/, false/*isASCII*/, getArena());
+            continue;
+         }
+
          if (outbufsize < 0) {
             // calculate max string length
             R_len_t maxlen = LENGTH(curs);
@@ -194,7 +221,8 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
                tmp.getBuffer(), tmp.length(), &status);
          STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
-         this->str[i].initialize(outbuf.data(), outrealsize, true/*memalloc*/, false/*killbom*/, false/*isASCII*/);
+         this->str[i].initialize(outbuf.data(), outrealsize, true/*memalloc*/, false/*killbom*/, false/*isASCII*/,
+            getArena());
 
          // version 3: use tmpbuf (slower than v2)
 //               UErrorCode status = U_ZERO_ERROR;
@@ -217,7 +245,10 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
 
    if (!_shallowrecycle) {
       for (R_len_t i=nrstr; i<this->n; ++i) {
-            this->str[i] = str[i%nrstr];
+         const String8& src = str[i%nrstr];
+         if (src.isNA()) continue;
+         this->str[i].initialize(src.c_str(), src.length(), !src.isReadOnly()/*memalloc*/,
+            false/*killbom*/, src.isASCII(), getArena());
       }
    }
 }
@@ -226,11 +257,22 @@ StriContainerUTF8::StriContainerUTF8(SEXP rstr, R_len_t _nrecycle, bool _shallow
 StriContainerUTF8::StriContainerUTF8(StriContainerUTF8& container)
    :    StriContainerBase((StriContainerBase&)container)
 {
+   this->arena = NULL; // arena-backed strings are copied onto the heap
+   this->passarena[0] = this->passarena[1] = NULL;
+   this->passcur = -1;
+   this->passowner.clear();
    if (container.str) {
       this->str = new String8[this->n];
       if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
       for (int i=0; i<this->n; ++i) {
-         this->str[i] = container.str[i];
+         if (!container.str[i].isNA() && container.str[i].isReadOnly()
+               && !container.isCHARSXPData(i)) {
+            // shares the buffer with another string in container: deep copy
+            this->str[i].initialize(container.str[i].c_str(), container.str[i].length(),
+               true/*memalloc*/, false/*killbom*/, container.str[i].isASCII());
+         }
+         else
+            this->str[i] = container.str[i];
       }
    }
    else {
@@ -243,12 +285,23 @@ StriContainerUTF8& StriContainerUTF8::operator=(StriContainerUTF8& container)
 {
    this->~StriContainerUTF8();
    (StriContainerBase&) (*this) = (StriContainerBase&)container;
+   this->arena = NULL; // arena-backed strings are copied onto the heap
+   this->passarena[0] = this->passarena[1] = NULL;
+   this->passcur = -1;
+   this->passowner.clear();
 
    if (container.str) {
       this->str = new String8[this->n];
       if (!this->str) throw StriException(MSG__MEM_ALLOC_ERROR);
       for (int i=0; i<this->n; ++i) {
-         this->str[i] = container.str[i];
+         if (!container.str[i].isNA() && container.str[i].isReadOnly()
+               && !container.isCHARSXPData(i)) {
+            // shares the buffer with another string in container: deep copy
+            this->str[i].initialize(container.str[i].c_str(), container.str[i].length(),
+               true/*memalloc*/, false/*killbom*/, container.str[i].isASCII());
+         }
+         else
+            this->str[i] = container.str[i];
       }
    }
    else {
@@ -268,6 +321,67 @@ StriContainerUTF8::~StriContainerUTF8()
       delete [] str;
       str = NULL;
    }
+
+   if (arena) {
+      delete arena;
+      arena = NULL;
+   }
+
+   for (int k=0; k<2; ++k) {
+      if (passarena[k]) {
+         delete passarena[k];
+         passarena[k] = NULL;
+      }
+   }
+   passcur = -1;
+}
+
+
+/** Start a new round of in-place replacements, see replaceAllAtPos()
+ *
+ * Two arenas are used in turns. The strings rewritten
+ * in the previous pass are read while new buffers are drawn from
+ * the other arena. That one is reset beforehand, so that the memory
+ * is not accumulated over many passes (e.g., patterns in
+ * stri_replace_all_*(..., vectorize_all=FALSE)) - the strings
+ * which still occupy it are copied to the previous pass' arena first.
+ *
+ * Each string is copied at most once per pass.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriContainerUTF8::beginPass()
+{
+   if (passcur < 0) {
+      passcur = 0;
+      passowner.assign(n, 0);
+   }
+   else
+      passcur = 1-passcur;
+
+   if (!passarena[passcur]) {
+      passarena[passcur] = new String8Arena();
+      if (!passarena[passcur]) throw StriException(MSG__MEM_ALLOC_ERROR);
+      return; // nothing to reset
+   }
+
+   // passarena[1-passcur] exists, as passarena[passcur] was used two passes ago
+   for (R_len_t i=0; i<n; ++i) {
+      if (passowner[i] != (unsigned char)(passcur+1)) continue;
+      passowner[i] = 0;
+      if (str[i].isNA()) continue; // setNA() doesn't update passowner
+
+      // setNA() doesn't free arena-backed buffers, old_s is valid until reset()
+      const char* old_s = str[i].c_str();
+      R_len_t old_n     = str[i].length();
+      bool old_isASCII  = str[i].isASCII();
+      str[i].setNA();
+      str[i].initialize(old_s, old_n, true/*memalloc*/,
+         false/*killbom*/, old_isASCII, passarena[1-passcur]);
+      passowner[i] = (unsigned char)(2-passcur);
+   }
+
+   passarena[passcur]->reset();
 }
 
 
@@ -311,6 +425,9 @@ SEXP StriContainerUTF8::toR() const
  *
  * @version 0.2-1 (Marek Gagolewski, 2014-03-22)
  *    returns original CHARSXP if possible for increased performance
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    read-only strings may share re-encoded data, see isCHARSXPData()
  */
 SEXP StriContainerUTF8::toR(R_len_t i) const
 {
@@ -323,9 +440,9 @@ SEXP StriContainerUTF8::toR(R_len_t i) const
    if (curs->isNA()) {
       return NA_STRING;
    }
-   else if (curs->isReadOnly()) {
+   else if (curs->isReadOnly() && isCHARSXPData(i)) {
       // if ReadOnly, then surely in ASCII or UTF-8 and without BOMS (see SEXP-constructor)
-      return STRING_ELT(sexp, i%n);
+      return STRING_ELT(sexp, (i%n)%LENGTH(sexp));
    }
    else {
       // This is already in UTF-8
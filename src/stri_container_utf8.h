@@ -72,12 +72,23 @@
  * @version 0.3-1 (Marek Gagolewski, 2014-11-02)
  *          New methods: set, getWritable, isNA;
  *          Always try to use shallow copy of char* data in SEXP-based constructor (be lazy)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          Repeated latin-1/native CHARSXPs are re-encoded only once
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          Deep copies of strings are stored in a String8Arena;
+ *          new methods: beginPass, replaceAllAtPos
  */
 class StriContainerUTF8 : public StriContainerBase {
 
    private:
 
       String8* str;  ///< data - \code{string}
+      String8Arena* arena;  ///< memory for deep copies, created on demand
+      String8Arena* passarena[2]; ///< memory for in-place replacements
+      int passcur;          ///< index of the current pass' arena, or -1
+      std::vector<unsigned char> passowner; ///< 1+index of the pass arena used by str[i], 0 if none
 
 
    public:
@@ -91,6 +102,47 @@ class StriContainerUTF8 : public StriContainerBase {
       SEXP toR() const;
 
 
+      /** get the arena which stores the strings' deep copies
+       *
+       * The memory is released together with this container,
+       * hence use it only for this->str's contents.
+       *
+       * @return arena
+       */
+      inline String8Arena* getArena() {
+         if (!arena) {
+            arena = new String8Arena();
+            if (!arena) throw StriException(MSG__MEM_ALLOC_ERROR);
+         }
+         return arena;
+      }
+
+
+      void beginPass();
+
+
+      /** Replace substrings in the ith string, see String8::replaceAllAtPos
+       *
+       * The new buffer is drawn from the current pass' arena,
+       * see beginPass()
+       *
+       * @param i index
+       */
+      inline void replaceAllAtPos(R_len_t i, R_len_t buf_size,
+         const char* replacement_cur_s, R_len_t replacement_cur_n,
+         std::deque< std::pair<R_len_t, R_len_t> >& occurrences)
+      {
+#ifndef NDEBUG
+         if (passcur < 0)
+            throw StriException("StriContainerUTF8::replaceAllAtPos(): no beginPass()");
+#endif
+         getWritable(i).replaceAllAtPos(buf_size,
+            replacement_cur_s, replacement_cur_n, occurrences,
+            passarena[passcur]);
+         passowner[i%n] = (unsigned char)(passcur+1);
+      }
+
+
       /** check if the vectorized ith element is NA
        * @param i index
        * @return true if is NA
@@ -104,6 +156,19 @@ class StriContainerUTF8 : public StriContainerBase {
       }
 
 
+      /** does the vectorized ith (read-only, non-NA) element point
+       * to the data of the CHARSXP it has been created from?
+       *
+       * If not, it shares the buffer with another (re-encoded) element.
+       *
+       * @param i index
+       * @return true or false
+       */
+      inline bool isCHARSXPData(R_len_t i) const {
+         return (CHAR(STRING_ELT(sexp, (i%n)%LENGTH(sexp))) == str[i%n].c_str());
+      }
+
+
       /** get the vectorized ith element
        * @param i index
        * @return string, read only
@@ -32,6 +32,8 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf8_indexable.h"
+#include <vector>
+#include <algorithm>
 
 
 /**
@@ -43,6 +45,7 @@
 StriContainerUTF8_indexable::StriContainerUTF8_indexable()
    : StriContainerUTF8()
 {
+   sparse_index_str = NULL;
    last_ind_back_str = NULL;
    last_ind_fwd_str = NULL;
 }
@@ -60,6 +63,7 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable()
 StriContainerUTF8_indexable::StriContainerUTF8_indexable(SEXP rstr, R_len_t _nrecycle, bool _shallowrecycle)
    : StriContainerUTF8(rstr, _nrecycle, _shallowrecycle)
 {
+   sparse_index_str = NULL;
    last_ind_back_str = NULL;
    last_ind_fwd_str = NULL;
 }
@@ -73,6 +77,7 @@ StriContainerUTF8_indexable::StriContainerUTF8_indexable(SEXP rstr, R_len_t _nre
 StriContainerUTF8_indexable::StriContainerUTF8_indexable(StriContainerUTF8_indexable& container)
    :    StriContainerUTF8((StriContainerUTF8&)container)
 {
+   sparse_index_str = NULL;
    last_ind_back_str = NULL;
    last_ind_fwd_str = NULL;
 }
@@ -90,11 +95,97 @@ StriContainerUTF8_indexable& StriContainerUTF8_indexable::operator=(StriContaine
 
    last_ind_back_str = NULL;
    last_ind_fwd_str = NULL;
+   sparse_index_str = NULL;
+   sparse_index.clear();
 
    return *this;
 }
 
 
+/** Prepare the sparse code point index for the i-th string, if it is long
+ *
+ * The index is kept for one string at a time (the most recently used one),
+ * which is what happens in, e.g., \code{stri_sub} on a single document
+ * with many \code{from}/\code{to} pairs.
+ *
+ * @param i string index (in container), a non-ASCII string
+ * @return whether the index may be used for the i-th string
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriContainerUTF8_indexable::useSparseIndex(R_len_t i)
+{
+   R_len_t cur_n = get(i).length();
+   if (cur_n < STRI__UTF8_INDEX_MIN_LENGTH) return false;
+
+   const char* cur_s = get(i).c_str();
+   if (sparse_index_str == cur_s) return true;
+
+   sparse_index.clear();
+   sparse_index.reserve((size_t)(cur_n/STRI__UTF8_INDEX_STEP+1));
+   R_len_t j = 0;
+   R_len_t jres = 0;
+   while (jres < cur_n) {
+      if (j % STRI__UTF8_INDEX_STEP == 0)
+         sparse_index.push_back(jres);
+      U8_FWD_1((const uint8_t*)cur_s, jres, cur_n);
+      ++j;
+   }
+   if (j % STRI__UTF8_INDEX_STEP == 0)
+      sparse_index.push_back(jres); // == cur_n
+
+   sparse_index_ncp = j;
+   sparse_index_nbytes = cur_n;
+   sparse_index_str = cur_s;
+   return true;
+}
+
+
+/** Convert a UChar32-based index to UTF-8 based using the sparse index
+ *
+ * @param wh code point index, 0-based, >= 0
+ * @return UTF-8 (byte) index
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+R_len_t StriContainerUTF8_indexable::sparseIndex_UChar32_to_UTF8(R_len_t wh) const
+{
+   if (wh >= sparse_index_ncp) wh = sparse_index_ncp;
+
+   R_len_t cur_n = sparse_index_nbytes;
+   R_len_t j = wh/STRI__UTF8_INDEX_STEP;
+   R_len_t jres = sparse_index[j];
+   j *= STRI__UTF8_INDEX_STEP;
+   while (j < wh && jres < cur_n) {
+      U8_FWD_1((const uint8_t*)sparse_index_str, jres, cur_n);
+      ++j;
+   }
+   return jres;
+}
+
+
+/** Convert a UTF-8 based index to UChar32 based using the sparse index
+ *
+ * @param b byte index, 0 <= b <= length in bytes
+ * @return the number of code points starting before b
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+R_len_t StriContainerUTF8_indexable::sparseIndex_UTF8_to_UChar32(R_len_t b) const
+{
+   R_len_t cur_n = sparse_index_nbytes;
+   R_len_t k = (R_len_t)(std::upper_bound(sparse_index.begin(), sparse_index.end(), b)
+      - sparse_index.begin()) - 1;
+   R_len_t i8 = sparse_index[k];
+   R_len_t i32 = k*STRI__UTF8_INDEX_STEP;
+   while (i8 < b && i8 < cur_n) {
+      U8_FWD_1((const uint8_t*)sparse_index_str, i8, cur_n);
+      ++i32;
+   }
+   return i32;
+}
+
+
 /** Convert BACKWARD UChar32-based index to UTF-8 based
  *
  * @param i string index (in container)
@@ -120,12 +211,17 @@ StriContainerUTF8_indexable& StriContainerUTF8_indexable::operator=(StriContaine
  *
  * @version 1.1.3 (Marek Gagolewski, 2017-03-21)
  *          Issue#227: buffering bug in stri_sub
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          use the sparse index for long strings
  */
 R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len_t wh)
 {
    R_len_t cur_n = get(i).length();
    if (wh <= 0) return cur_n;
    if (get(i).isASCII()) return std::max(cur_n-wh, 0);
+   if (useSparseIndex(i))
+      return sparseIndex_UChar32_to_UTF8(std::max(sparse_index_ncp-wh, 0));
    const char* cur_s = get(i).c_str();
 
 #ifndef NDEBUG
@@ -207,11 +303,15 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_back(R_len_t i, R_len
  *
  * @version 1.1.3 (Marek Gagolewski, 2017-03-21)
  *          Issue#227: buffering bug in stri_sub
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          use the sparse index for long strings
  */
 R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_t wh)
 {
    if (wh <= 0) return 0;
    if (get(i).isASCII()) return std::min(wh, get(i).length());
+   if (useSparseIndex(i)) return sparseIndex_UChar32_to_UTF8(wh);
 
    R_len_t cur_n = get(i).length();
    const char* cur_s = get(i).c_str();
@@ -288,6 +388,9 @@ R_len_t StriContainerUTF8_indexable::UChar32_to_UTF8_index_fwd(R_len_t i, R_len_
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *          use String8::isASCII
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          use the sparse index for long strings
  */
 void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
    int* i1, int* i2, const int ni, int adj1, int adj2)
@@ -303,6 +406,17 @@ void StriContainerUTF8_indexable::UTF8_to_UChar32_index(R_len_t i,
    const char* cstr = get(i).c_str();
    const int nstr = get(i).length();
 
+   if (useSparseIndex(i)) {
+      // each index is converted separately, in O(log(nstr)+STRI__UTF8_INDEX_STEP)
+      for (int j=0; j<ni; ++j) {
+         if (i1[j] <= nstr)
+            i1[j] = sparseIndex_UTF8_to_UChar32(std::max(i1[j], 0)) + adj1;
+         if (i2[j] <= nstr)
+            i2[j] = sparseIndex_UTF8_to_UChar32(std::max(i2[j], 0)) + adj2;
+      }
+      return;
+   }
+
    int j1 = 0;
    int j2 = 0;
 
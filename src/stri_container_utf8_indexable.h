@@ -36,6 +36,13 @@
 #include "stri_container_utf8.h"
 
 
+/** every how many code points a byte offset is stored in the sparse index */
+#define STRI__UTF8_INDEX_STEP 64
+
+/** strings of at least this many bytes get a sparse index */
+#define STRI__UTF8_INDEX_MIN_LENGTH 4096
+
+
 /**
  * A class to handle conversion between R character
  * vectors and UTF-8 string vectors,
@@ -47,6 +54,9 @@
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *          use String8::isASCII
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          sparse code point index for long non-ASCII strings
  */
 class StriContainerUTF8_indexable : public StriContainerUTF8 {
 
@@ -62,6 +72,18 @@ class StriContainerUTF8_indexable : public StriContainerUTF8 {
       R_len_t last_ind_back_utf8;
       const char* last_ind_back_str;
 
+      // sparse_index[k] is the byte offset of the (k*STRI__UTF8_INDEX_STEP)-th
+      // code point in sparse_index_str, which consists of sparse_index_ncp
+      // code points (sparse_index_nbytes bytes); built on demand for long strings only
+      std::vector<R_len_t> sparse_index;
+      R_len_t sparse_index_ncp;
+      R_len_t sparse_index_nbytes;
+      const char* sparse_index_str;
+
+      bool useSparseIndex(R_len_t i);
+      R_len_t sparseIndex_UChar32_to_UTF8(R_len_t wh) const;
+      R_len_t sparseIndex_UTF8_to_UChar32(R_len_t b) const;
+
    public:
 
       StriContainerUTF8_indexable();
@@ -448,6 +448,9 @@ SEXP stri_enc_toascii(SEXP str)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    calc required buf size for each string separately
  */
 SEXP stri_encode_from_marked(SEXP str, SEXP to, SEXP to_raw)
 {
@@ -473,15 +476,10 @@ SEXP stri_encode_from_marked(SEXP str, SEXP to, SEXP to_raw)
    SEXP ret;
    STRI__PROTECT(ret = Rf_allocVector(to_raw_logical?VECSXP:STRSXP, str_n));
 
-   // calculate required buf size
-   R_len_t bufsize = 0;
-   for (R_len_t i=0; i<str_n; ++i) {
-      if (!str_cont.isNA(i) && str_cont.get(i).length() > bufsize)
-         bufsize = str_cont.get(i).length();
-   }
-   bufsize = UCNV_GET_MAX_BYTES_FOR_STRING(bufsize, ucnv_getMaxCharSize(uconv_to));
-   // "The calculated size is guaranteed to be sufficient for this conversion."
-   String8buf buf(bufsize);
+   // required buf size is determined for each string separately
+   // (str_cont converts the strings lazily)
+   int maxcharsize = ucnv_getMaxCharSize(uconv_to);
+   String8buf buf(0);
 
    for (R_len_t i=0; i<str_n; ++i) {
       if (str_cont.isNA(i)) {
@@ -495,6 +493,9 @@ SEXP stri_encode_from_marked(SEXP str, SEXP to, SEXP to_raw)
       if (!curs_tmp)
          throw StriException(MSG__INTERNAL_ERROR);
 
+      // "The calculated size is guaranteed to be sufficient for this conversion."
+      buf.resize(UCNV_GET_MAX_BYTES_FOR_STRING(curn_tmp, maxcharsize), false/*destroy contents*/);
+
       UErrorCode status = U_ZERO_ERROR;
       ucnv_resetFromUnicode(uconv_to);
       R_len_t bufneed = ucnv_fromUChars(uconv_to, buf.data(), buf.size(),
@@ -51,10 +51,15 @@
  *
  * @version 1.1.6 (Steve Grubb, 2017-07-20)
  *          if ((char)c >= 32 || (char)c <= 126) should be &&
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
 */
 SEXP stri_escape_unicode(SEXP str)
 {
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_escape_unicode(str_unique))
 
    STRI__ERROR_HANDLER_BEGIN(1)
    R_len_t str_length = LENGTH(str);
@@ -116,7 +116,8 @@ SEXP stri_stats_latex(SEXP str);
 
 // trans_transliterate.cpp:
 SEXP stri_trans_list();
-SEXP stri_trans_general(SEXP str, SEXP id);
+SEXP stri_trans_general(SEXP str, SEXP id, SEXP nthreads);
+SEXP stri_trans_pipeline(SEXP str, SEXP steps);
 
 // utils.cpp
 SEXP stri_list2matrix(SEXP x, SEXP byrow=Rf_ScalarLogical(FALSE),
@@ -133,6 +134,13 @@ SEXP stri_enc_toutf8(SEXP str, SEXP is_unknown_8bit=Rf_ScalarLogical(FALSE),
 SEXP stri_enc_toascii(SEXP str);
 
 
+// files.cpp:
+SEXP stri_read_lines(SEXP fname, SEXP encoding=R_NilValue);
+SEXP stri_read_lines_open(SEXP fname, SEXP encoding=R_NilValue);
+SEXP stri_read_lines_next(SEXP con, SEXP n);
+SEXP stri_read_lines_close(SEXP con);
+SEXP stri_write_lines(SEXP str, SEXP fname, SEXP encoding, SEXP sep);
+
 // encoding_detection.cpp:
 SEXP stri_enc_detect2(SEXP str, SEXP loc=R_NilValue);
 SEXP stri_enc_detect(SEXP str, SEXP filter_angle_brackets=Rf_ScalarLogical(FALSE));
@@ -211,14 +219,16 @@ SEXP stri_subset_coll_replacement(SEXP str, SEXP pattern, SEXP negate, SEXP opts
 SEXP stri_detect_fixed(SEXP str, SEXP pattern, SEXP negate=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
 SEXP stri_count_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
 SEXP stri_locate_all_fixed(SEXP str, SEXP pattern,
-   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
+   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_fixed=R_NilValue);
 SEXP stri_locate_first_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
 SEXP stri_locate_last_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
 SEXP stri_extract_first_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
 SEXP stri_extract_last_fixed(SEXP str, SEXP pattern, SEXP opts_fixed=R_NilValue);
 SEXP stri_extract_all_fixed(SEXP str, SEXP pattern,
    SEXP simplify=Rf_ScalarLogical(FALSE),
-   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
+   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_fixed=R_NilValue);
 SEXP stri_replace_all_fixed(SEXP str, SEXP pattern, SEXP replacement,
    SEXP vectorize_all=Rf_ScalarLogical(TRUE), SEXP opts_fixed=R_NilValue);
 SEXP stri_replace_first_fixed(SEXP str, SEXP pattern, SEXP replacement,
@@ -227,7 +237,8 @@ SEXP stri_replace_last_fixed(SEXP str, SEXP pattern, SEXP replacement,
    SEXP opts_fixed=R_NilValue);
 SEXP stri_split_fixed(SEXP str, SEXP split, SEXP n=Rf_ScalarInteger(-1),
    SEXP omit_empty=Rf_ScalarLogical(FALSE), SEXP tokens_only=Rf_ScalarLogical(FALSE),
-   SEXP simplify=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
+   SEXP simplify=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_fixed=R_NilValue);
 SEXP stri_subset_fixed(SEXP str, SEXP pattern,
    SEXP omit_na=Rf_ScalarLogical(FALSE), SEXP negate=Rf_ScalarLogical(FALSE), SEXP opts_fixed=R_NilValue);
 SEXP stri_endswith_fixed(SEXP str, SEXP pattern, SEXP to=Rf_ScalarInteger(-1),
@@ -239,7 +250,8 @@ SEXP stri_subset_fixed_replacement(SEXP str, SEXP pattern, SEXP negate, SEXP opt
 SEXP stri_detect_regex(SEXP str, SEXP pattern, SEXP negate=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue);
 SEXP stri_count_regex(SEXP str, SEXP pattern, SEXP opts_regex=R_NilValue);
 SEXP stri_locate_all_regex(SEXP str, SEXP pattern,
-   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue);
+   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_regex=R_NilValue);
 SEXP stri_locate_first_regex(SEXP str, SEXP pattern, SEXP opts_regex=R_NilValue);
 SEXP stri_locate_last_regex(SEXP str, SEXP pattern, SEXP opts_regex=R_NilValue);
 SEXP stri_replace_all_regex(SEXP str, SEXP pattern, SEXP replacement,
@@ -250,21 +262,23 @@ SEXP stri_replace_last_regex(SEXP str, SEXP pattern, SEXP replacement,
    SEXP opts_regex=R_NilValue);
 SEXP stri_split_regex(SEXP str, SEXP pattern, SEXP n=Rf_ScalarInteger(-1),
    SEXP omit_empty=Rf_ScalarLogical(FALSE), SEXP tokens_only=Rf_ScalarLogical(FALSE),
-   SEXP simplify=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue);
+   SEXP simplify=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_regex=R_NilValue);
 SEXP stri_subset_regex(SEXP str, SEXP pattern,
    SEXP omit_na=Rf_ScalarLogical(FALSE), SEXP negate=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue);
 SEXP stri_extract_first_regex(SEXP str, SEXP pattern, SEXP opts_regex=R_NilValue);
 SEXP stri_extract_last_regex(SEXP str, SEXP pattern, SEXP opts_regex=R_NilValue);
 SEXP stri_extract_all_regex(SEXP str, SEXP pattern,
    SEXP simplify=Rf_ScalarLogical(FALSE), SEXP omit_no_match=Rf_ScalarLogical(FALSE),
-   SEXP opts_regex=R_NilValue);
+   SEXP flatten=Rf_ScalarLogical(FALSE), SEXP opts_regex=R_NilValue);
 SEXP stri_match_first_regex(SEXP str, SEXP pattern,
    SEXP cg_missing=Rf_ScalarString(NA_STRING), SEXP opts_regex=R_NilValue);
 SEXP stri_match_last_regex(SEXP str, SEXP pattern,
    SEXP cg_missing=Rf_ScalarString(NA_STRING), SEXP opts_regex=R_NilValue);
 SEXP stri_match_all_regex(SEXP str, SEXP pattern,
    SEXP omit_no_match=Rf_ScalarLogical(FALSE),
-   SEXP cg_missing=Rf_ScalarString(NA_STRING), SEXP opts_regex=R_NilValue);
+   SEXP cg_missing=Rf_ScalarString(NA_STRING), SEXP flatten=Rf_ScalarLogical(FALSE),
+   SEXP opts_regex=R_NilValue);
 SEXP stri_subset_regex_replacement(SEXP str, SEXP pattern, SEXP negate, SEXP opts_regex, SEXP value);
 
 SEXP stri_count_charclass(SEXP str, SEXP pattern);
@@ -273,18 +287,20 @@ SEXP stri_extract_first_charclass(SEXP str, SEXP pattern);
 SEXP stri_extract_last_charclass(SEXP str, SEXP pattern);
 SEXP stri_extract_all_charclass(SEXP str, SEXP pattern,
    SEXP merge=Rf_ScalarLogical(TRUE), SEXP simplify=Rf_ScalarLogical(FALSE),
-   SEXP omit_no_match=Rf_ScalarLogical(FALSE));
+   SEXP omit_no_match=Rf_ScalarLogical(FALSE), SEXP flatten=Rf_ScalarLogical(FALSE));
 SEXP stri_locate_first_charclass(SEXP str, SEXP pattern);
 SEXP stri_locate_last_charclass(SEXP str, SEXP pattern);
 SEXP stri_locate_all_charclass(SEXP str, SEXP pattern,
-   SEXP merge=Rf_ScalarLogical(TRUE), SEXP omit_no_match=Rf_ScalarLogical(FALSE));
+   SEXP merge=Rf_ScalarLogical(TRUE), SEXP omit_no_match=Rf_ScalarLogical(FALSE),
+   SEXP flatten=Rf_ScalarLogical(FALSE));
 SEXP stri_replace_last_charclass(SEXP str, SEXP pattern, SEXP replacement);
 SEXP stri_replace_first_charclass(SEXP str, SEXP pattern, SEXP replacement);
 SEXP stri_replace_all_charclass(SEXP str, SEXP pattern, SEXP replacement,
    SEXP merge=Rf_ScalarLogical(FALSE), SEXP vectorize_all=Rf_ScalarLogical(TRUE));
 SEXP stri_split_charclass(SEXP str, SEXP pattern, SEXP n=Rf_ScalarInteger(-1),
    SEXP omit_empty=Rf_ScalarLogical(FALSE),
-   SEXP tokens_only=Rf_ScalarLogical(FALSE), SEXP simplify=Rf_ScalarLogical(FALSE));
+   SEXP tokens_only=Rf_ScalarLogical(FALSE), SEXP simplify=Rf_ScalarLogical(FALSE),
+   SEXP flatten=Rf_ScalarLogical(FALSE));
 SEXP stri_endswith_charclass(SEXP str, SEXP pattern, SEXP to=Rf_ScalarInteger(-1));
 SEXP stri_startswith_charclass(SEXP str, SEXP pattern, SEXP from=Rf_ScalarInteger(1));
 SEXP stri_subset_charclass(SEXP str, SEXP pattern, SEXP omit_na=Rf_ScalarLogical(FALSE), SEXP negate=Rf_ScalarLogical(FALSE));
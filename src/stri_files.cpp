@@ -0,0 +1,775 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#if defined(_WIN32) || defined(_WIN64)
+#define WIN32_LEAN_AND_MEAN
+#define NOGDI
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "stri_stringi.h"
+#include "stri_files.h"
+#include "stri_newline.h"
+#include "stri_container_utf8.h"
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+
+#define STRI__LINEREADER_UTF8  0
+#define STRI__LINEREADER_ASCII 1
+#define STRI__LINEREADER_ICU   2
+
+#define STRI__LINEREADER_BUFSIZE 65536
+#define STRI__LINEREADER_PREFETCH (16*1024*1024)
+#define STRI__LINEREADER_ADVISE_EVERY 65536
+
+#define STRI__LINEWRITER_BUFSIZE 65536
+#define STRI__LINEWRITER_CHUNK 16384  /* bytes of UTF-8 input converted at once */
+
+
+/** Map a file into memory
+ *
+ * @param fname file name, in the native encoding
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriMappedFile::StriMappedFile(const char* fname)
+{
+   m_data = NULL;
+   m_size = 0;
+   m_released = 0;
+
+#if defined(_WIN32) || defined(_WIN64)
+   HANDLE file = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL,
+      OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+   if (file == INVALID_HANDLE_VALUE)
+      throw StriException(MSG__FILE_OPEN_ERROR, fname);
+
+   LARGE_INTEGER size;
+   if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      throw StriException(MSG__FILE_OPEN_ERROR, fname);
+   }
+   if ((unsigned long long)size.QuadPart > (unsigned long long)(size_t)-1) {
+      CloseHandle(file);
+      throw StriException(MSG__FILE_MAP_ERROR, fname);
+   }
+   m_size = (size_t)size.QuadPart;
+
+   if (m_size > 0) {
+      // the view keeps references to the mapping and the file
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping)
+         m_data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (mapping) CloseHandle(mapping);
+      if (!m_data) {
+         CloseHandle(file);
+         throw StriException(MSG__FILE_MAP_ERROR, fname);
+      }
+   }
+   CloseHandle(file);
+#else
+   int fd = open(fname, O_RDONLY);
+   if (fd < 0)
+      throw StriException(MSG__FILE_OPEN_ERROR, fname);
+
+   struct stat st;
+   if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw StriException(MSG__FILE_OPEN_ERROR, fname);
+   }
+   if ((unsigned long long)st.st_size > (unsigned long long)(size_t)-1) {
+      close(fd);
+      throw StriException(MSG__FILE_MAP_ERROR, fname);
+   }
+   m_size = (size_t)st.st_size;
+
+   if (m_size > 0) {
+      // the mapping stays valid after the file is closed
+      void* data = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+         close(fd);
+         throw StriException(MSG__FILE_MAP_ERROR, fname);
+      }
+#ifdef MADV_SEQUENTIAL
+      madvise(data, m_size, MADV_SEQUENTIAL);
+#endif
+      m_data = (const char*)data;
+   }
+   close(fd);
+#endif
+}
+
+
+/** Unmap the file
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriMappedFile::~StriMappedFile()
+{
+   if (!m_data) return;
+#if defined(_WIN32) || defined(_WIN64)
+   UnmapViewOfFile((LPCVOID)m_data);
+#else
+   munmap((void*)m_data, m_size);
+#endif
+   m_data = NULL;
+}
+
+
+/** Ask the OS to start reading a part of the file in the background
+ *
+ * @param from offset
+ * @param n number of bytes
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriMappedFile::prefetch(size_t from, size_t n) const
+{
+#if !(defined(_WIN32) || defined(_WIN64)) && defined(MADV_WILLNEED)
+   if (!m_data || from >= m_size) return;
+   size_t page = (size_t)sysconf(_SC_PAGESIZE);
+   size_t start = from - from%page;
+   if (n > m_size-start) n = m_size-start;
+   madvise((void*)(m_data+start), n, MADV_WILLNEED);
+#endif
+}
+
+
+/** Let the OS drop the pages that will not be accessed anymore
+ *
+ * This keeps the memory use constant when reading huge files.
+ *
+ * @param upto offset; the pages entirely before it are released
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriMappedFile::release(size_t upto)
+{
+#if !(defined(_WIN32) || defined(_WIN64)) && defined(MADV_DONTNEED)
+   if (!m_data) return;
+   size_t page = (size_t)sysconf(_SC_PAGESIZE);
+   upto -= upto%page;
+   if (upto <= m_released) return;
+   madvise((void*)(m_data+m_released), upto-m_released, MADV_DONTNEED);
+   m_released = upto;
+#endif
+}
+
+
+/** Open a file for reading text lines
+ *
+ * @param fname file name, in the native encoding
+ * @param encoding input encoding, NULL for the default one
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriLineReader::StriLineReader(const char* fname, const char* encoding) :
+   m_file(fname), m_encoding(encoding ? encoding : ""),
+   m_ucnv(encoding ? m_encoding.c_str() : NULL)
+{
+   m_pos = 0;
+   m_done = false;
+   m_any = false;
+   m_upos = m_un = 0;
+   m_flushed = false;
+   m_after_cr = false;
+
+   UConverter* uconv = m_ucnv.getConverter(true /*register_callbacks*/);
+   UErrorCode status = U_ZERO_ERROR;
+   const char* ucnv_name = ucnv_getName(uconv, &status);
+   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+   if (!strcmp(ucnv_name, "UTF-8"))
+      m_mode = STRI__LINEREADER_UTF8;
+   else if (!strcmp(ucnv_name, "US-ASCII"))
+      m_mode = STRI__LINEREADER_ASCII;
+   else
+      m_mode = STRI__LINEREADER_ICU;
+}
+
+
+/** Get the next text line
+ *
+ * @param s [out] the line, in UTF-8, valid until the next call
+ *    or the reader's destruction
+ * @param n [out] number of bytes in s
+ * @return false if there are no more lines
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriLineReader::next(const char*& s, R_len_t& n)
+{
+   if (m_done) return false;
+   if (m_mode == STRI__LINEREADER_ICU) return nextICU(s, n);
+
+   const char* data = m_file.data();
+   size_t size = m_file.size();
+   size_t start = m_pos;
+   size_t next_pos;
+   size_t end = stri__find_newline(data, start, size, next_pos,
+      m_mode == STRI__LINEREADER_UTF8);
+
+   m_pos = next_pos;
+   m_done = (m_pos >= size);
+   m_any = true;
+
+   if (end-start > (size_t)INT_MAX)
+      throw StriException(MSG__LINE_TOO_LONG);
+   s = data+start;
+   n = (R_len_t)(end-start);
+
+   bool valid = (m_mode == STRI__LINEREADER_UTF8)
+      ? (stri__enc_check_utf8(s, n, false) > 0.0)
+      : (stri__enc_check_ascii(s, n, false) > 0.0);
+   if (!valid) {
+      // invalid bytes (or NULs): let ICU substitute them (and warn)
+      UErrorCode status = U_ZERO_ERROR;
+      UnicodeString str(s, n, m_ucnv.getConverter(true), status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      setConverted(str.getBuffer(), (size_t)str.length(), s, n);
+   }
+   return true;
+}
+
+
+/** Release the part of the file read so far and prefetch
+ * the next one, see StriMappedFile
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineReader::advise()
+{
+   m_file.release(m_pos);
+   if (!m_done)
+      m_file.prefetch(m_pos, STRI__LINEREADER_PREFETCH);
+}
+
+
+/** Convert a line to UTF-8 and store it in m_line
+ *
+ * @param s UTF-16 string
+ * @param n number of code units in s
+ * @param out [out] m_line's contents
+ * @param out_n [out] number of bytes in out
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineReader::setConverted(const UChar* s, size_t n, const char*& out, R_len_t& out_n)
+{
+   if (n > (size_t)INT_MAX/3)
+      throw StriException(MSG__LINE_TOO_LONG);
+   for (size_t k=0; k<n; ++k)
+      if (s[k] == 0) throw StriException(MSG__EMBEDDED_NUL);
+
+   m_line.clear();
+   UnicodeString str(false, s, (int32_t)n); // read-only alias
+   str.toUTF8String(m_line); // unpaired surrogates -> U+FFFD
+   out = m_line.data();
+   out_n = (R_len_t)m_line.size();
+}
+
+
+/** Convert the next chunk of the file to UTF-16
+ *
+ * @return false if the whole file has been converted and read
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriLineReader::fillBuffer()
+{
+   if (m_ubuf.empty())
+      m_ubuf.resize(STRI__LINEREADER_BUFSIZE);
+   m_upos = m_un = 0;
+
+   size_t size = m_file.size();
+   if (size == 0) m_flushed = true;
+   UConverter* uconv = m_ucnv.getConverter(true);
+   while (!m_flushed) {
+      const char* source = m_file.data()+m_pos;
+      size_t chunk = std::min(size-m_pos, (size_t)STRI__LINEREADER_BUFSIZE);
+      UBool flush = (m_pos+chunk == size);
+      UChar* target = &m_ubuf[0];
+
+      UErrorCode status = U_ZERO_ERROR;
+      ucnv_toUnicode(uconv, &target, target+m_ubuf.size(),
+         &source, source+chunk, NULL, flush, &status);
+      bool overflow = (status == U_BUFFER_OVERFLOW_ERROR);
+      if (overflow) status = U_ZERO_ERROR;
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+      m_pos = (size_t)(source-m_file.data());
+      m_un = (size_t)(target-&m_ubuf[0]);
+      if (flush && !overflow) m_flushed = true;
+      if (m_un > 0) return true;
+   }
+   return false;
+}
+
+
+/** Get the next text line, ICU mode
+ *
+ * @param s [out] the line, in UTF-8
+ * @param n [out] number of bytes in s
+ * @return false if there are no more lines
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriLineReader::nextICU(const char*& s, R_len_t& n)
+{
+   m_uline.clear();
+   while (true) {
+      if (m_upos >= m_un && !fillBuffer()) {
+         m_done = true;
+         if (m_uline.empty() && m_any)
+            return false; // a newline marker at the end of the file
+         break;
+      }
+
+      UChar c = m_ubuf[m_upos++];
+      if (m_after_cr) {
+         m_after_cr = false;
+         if (c == ASCII_LF) continue; // CR+LF
+      }
+
+      if (c == ASCII_CR) {
+         m_after_cr = true;
+         break;
+      }
+      else if (c == ASCII_LF || c == ASCII_VT || c == ASCII_FF ||
+            c == UCHAR_NEL || c == UCHAR_LS || c == UCHAR_PS)
+         break;
+
+      m_uline.push_back(c);
+   }
+
+   m_any = true;
+   setConverted(m_uline.empty() ? NULL : &m_uline[0], m_uline.size(), s, n);
+   return true;
+}
+
+
+/** Open a file for writing
+ *
+ * @param fname file name (native encoding)
+ * @param encoding output encoding, NULL for the default one
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriLineWriter::StriLineWriter(const char* fname, const char* encoding) :
+   m_file(NULL),
+   m_fname(fname),
+   m_encoding(encoding ? encoding : ""),
+   m_ucnv(encoding ? m_encoding.c_str() : NULL),
+   m_buf(STRI__LINEWRITER_BUFSIZE),
+   m_n(0)
+{
+   m_ucnv.getConverter(true /*register_callbacks*/);
+   m_utf8 = m_ucnv.isUTF8();
+   if (!m_utf8)
+      m_ubuf.resize(STRI__LINEWRITER_CHUNK+1);
+
+   m_file = fopen(fname, "wb");
+   if (!m_file)
+      throw StriException(MSG__FILE_OPEN_ERROR, fname);
+}
+
+
+/** Close the file (without flushing) if close() has not been called
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriLineWriter::~StriLineWriter()
+{
+   if (m_file) {
+      fclose(m_file);
+      m_file = NULL;
+   }
+}
+
+
+/** Write the buffer's contents to the file
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineWriter::flushBuffer()
+{
+   if (m_n > 0 && fwrite(&m_buf[0], 1, m_n, m_file) != m_n)
+      throw StriException(MSG__FILE_WRITE_ERROR, m_fname.c_str());
+   m_n = 0;
+}
+
+
+/** Convert a chunk of text to the output encoding and buffer the result
+ *
+ * @param s UTF-16 text
+ * @param n number of UChars in s
+ * @param flush whether this is the end of the text
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineWriter::convert(const UChar* s, size_t n, bool flush)
+{
+   UConverter* uconv = m_ucnv.getConverter(true);
+   const UChar* s_end = s+n;
+   while (true) {
+      char* target = &m_buf[0]+m_n;
+      UErrorCode status = U_ZERO_ERROR;
+      ucnv_fromUnicode(uconv, &target, &m_buf[0]+m_buf.size(),
+         &s, s_end, NULL, (UBool)flush, &status);
+      m_n = (size_t)(target-&m_buf[0]);
+      if (status == U_BUFFER_OVERFLOW_ERROR) {
+         flushBuffer();
+         continue;
+      }
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      return;
+   }
+}
+
+
+/** Write text
+ *
+ * @param s UTF-8 text
+ * @param n number of bytes in s
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineWriter::write(const char* s, R_len_t n)
+{
+   if (m_utf8) {
+      if (m_n+(size_t)n > m_buf.size()) {
+         flushBuffer();
+         if ((size_t)n > m_buf.size()) {  // write long strings directly
+            if (fwrite(s, 1, (size_t)n, m_file) != (size_t)n)
+               throw StriException(MSG__FILE_WRITE_ERROR, m_fname.c_str());
+            return;
+         }
+      }
+      memcpy(&m_buf[0]+m_n, s, (size_t)n);
+      m_n += (size_t)n;
+      return;
+   }
+
+   // convert at most STRI__LINEWRITER_CHUNK bytes at a time,
+   // not splitting UTF-8 sequences
+   R_len_t i = 0;
+   while (i < n) {
+      R_len_t j = (n-i > STRI__LINEWRITER_CHUNK) ? i+STRI__LINEWRITER_CHUNK : n;
+      for (int k = 0; k < 3 && j < n && j > i+1 && U8_IS_TRAIL(s[j]); ++k)
+         --j;
+
+      int32_t un = 0;
+      UErrorCode status = U_ZERO_ERROR;
+      u_strFromUTF8WithSub(&m_ubuf[0], (int32_t)m_ubuf.size(), &un,
+         s+i, j-i, 0xFFFD, NULL, &status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+      convert(&m_ubuf[0], (size_t)un, false);
+      i = j;
+   }
+}
+
+
+/** Finish writing and close the file
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriLineWriter::close()
+{
+   if (!m_utf8)
+      convert(NULL, 0, true);
+   flushBuffer();
+   FILE* f = m_file;
+   m_file = NULL;
+   if (fclose(f) != 0)
+      throw StriException(MSG__FILE_WRITE_ERROR, m_fname.c_str());
+}
+
+
+/** Read consecutive text lines
+ *
+ * @param reader line reader
+ * @param box a protected list of length 1; the lines are stored
+ *    in its first element (it is reallocated as needed)
+ * @param nmax maximal number of lines to read
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__read_lines(StriLineReader& reader, SEXP box, R_len_t nmax)
+{
+   // the number of lines is not known in advance
+   SEXP ret;
+   SET_VECTOR_ELT(box, 0, ret = Rf_allocVector(STRSXP, std::min(nmax, (R_len_t)1024)));
+
+   R_len_t nlines = 0;
+   const char* s;
+   R_len_t n;
+   while (nlines < nmax && reader.next(s, n)) {
+      if (nlines == LENGTH(ret)) {
+         R_len_t newsize = (nlines > nmax/2) ? nmax : 2*nlines;
+         SET_VECTOR_ELT(box, 0, ret = Rf_lengthgets(ret, newsize));
+      }
+      SET_STRING_ELT(ret, nlines++, Rf_mkCharLenCE(s, n, CE_UTF8));
+      if (nlines%STRI__LINEREADER_ADVISE_EVERY == 0)
+         reader.advise();
+   }
+   reader.advise();
+
+   if (nlines < LENGTH(ret))
+      SET_VECTOR_ELT(box, 0, Rf_lengthgets(ret, nlines));
+}
+
+
+/** Get the file name argument
+ *
+ * @param fname single string
+ * @return file name, tilde-expanded, in the native encoding
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+const char* stri__prepare_arg_fname(SEXP fname)
+{
+   PROTECT(fname = stri_prepare_arg_string_1(fname, "fname"));
+   if (STRING_ELT(fname, 0) == NA_STRING) {
+      UNPROTECT(1);
+      Rf_error(MSG__ARG_EXPECTED_NOT_NA, "fname"); // allowed here
+   }
+   const char* expanded = R_ExpandFileName(Rf_translateChar(STRING_ELT(fname, 0)));
+   char* ret = R_alloc(strlen(expanded)+1, (int)sizeof(char)); // freed automatically
+   strcpy(ret, expanded);
+   UNPROTECT(1);
+   return ret;
+}
+
+
+/**
+ * Read text lines from a file
+ *
+ * @param fname single string, file name
+ * @param encoding single string, input encoding,
+ *    NULL or "" for the default one
+ *
+ * @return character vector
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_read_lines(SEXP fname, SEXP encoding)
+{
+   const char* fname_val = stri__prepare_arg_fname(fname);
+   const char* encoding_val = stri__prepare_arg_enc(encoding, "encoding", true);
+
+   STRI__ERROR_HANDLER_BEGIN(0)
+   StriLineReader reader(fname_val, encoding_val);
+
+   SEXP box;
+   STRI__PROTECT(box = Rf_allocVector(VECSXP, 1));
+   stri__read_lines(reader, box, INT_MAX);
+
+   STRI__UNPROTECT_ALL
+   return VECTOR_ELT(box, 0);
+   STRI__ERROR_HANDLER_END({/* nothing special on error */})
+}
+
+
+/** Finalizer for line reader handles
+ *
+ * @param con external pointer
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__read_lines_finalizer(SEXP con)
+{
+   StriLineReader* reader = (StriLineReader*)R_ExternalPtrAddr(con);
+   if (reader) {
+      delete reader;
+      R_ClearExternalPtr(con);
+   }
+}
+
+
+/** Get the line reader referred to by a handle
+ *
+ * @param con object returned by stri_read_lines_open
+ * @return reader, never NULL
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriLineReader* stri__prepare_arg_line_reader(SEXP con)
+{
+   if (TYPEOF(con) != EXTPTRSXP || R_ExternalPtrTag(con) != Rf_install("stri_line_reader"))
+      Rf_error(MSG__ARG_EXPECTED_LINE_READER, "con"); // allowed here
+   StriLineReader* reader = (StriLineReader*)R_ExternalPtrAddr(con);
+   if (!reader)
+      Rf_error(MSG__LINE_READER_CLOSED); // allowed here
+   return reader;
+}
+
+
+/**
+ * Open a file for reading text lines in chunks
+ *
+ * @param fname single string, file name
+ * @param encoding single string, input encoding,
+ *    NULL or "" for the default one
+ *
+ * @return external pointer of class stri_line_reader
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_read_lines_open(SEXP fname, SEXP encoding)
+{
+   const char* fname_val = stri__prepare_arg_fname(fname);
+   const char* encoding_val = stri__prepare_arg_enc(encoding, "encoding", true);
+
+   StriLineReader* reader = NULL;
+   STRI__ERROR_HANDLER_BEGIN(0)
+   reader = new StriLineReader(fname_val, encoding_val);
+   if (!reader) throw StriException(MSG__MEM_ALLOC_ERROR);
+   reader->advise();
+
+   SEXP ret;
+   STRI__PROTECT(ret = R_MakeExternalPtr(reader, Rf_install("stri_line_reader"), R_NilValue));
+   reader = NULL; // owned by ret now
+   R_RegisterCFinalizerEx(ret, stri__read_lines_finalizer, TRUE);
+   Rf_setAttrib(ret, R_ClassSymbol, Rf_mkString("stri_line_reader"));
+
+   STRI__UNPROTECT_ALL
+   return ret;
+   STRI__ERROR_HANDLER_END({
+      if (reader) { delete reader; reader = NULL; }
+   })
+}
+
+
+/**
+ * Read the next chunk of text lines
+ *
+ * @param con object returned by stri_read_lines_open
+ * @param n single integer, maximal number of lines to read
+ *
+ * @return character vector, of length 0 if there are no more lines
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_read_lines_next(SEXP con, SEXP n)
+{
+   StriLineReader* reader = stri__prepare_arg_line_reader(con);
+   int n_val = stri__prepare_arg_integer_1_notNA(n, "n");
+   if (n_val < 0)
+      Rf_error(MSG__EXPECTED_NONNEGATIVE, "n"); // allowed here
+
+   STRI__ERROR_HANDLER_BEGIN(0)
+   SEXP box;
+   STRI__PROTECT(box = Rf_allocVector(VECSXP, 1));
+   stri__read_lines(*reader, box, n_val);
+
+   STRI__UNPROTECT_ALL
+   return VECTOR_ELT(box, 0);
+   STRI__ERROR_HANDLER_END({/* nothing special on error */})
+}
+
+
+/**
+ * Close a line reader
+ *
+ * @param con object returned by stri_read_lines_open
+ *
+ * @return NULL
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_read_lines_close(SEXP con)
+{
+   stri__prepare_arg_line_reader(con); // check
+   stri__read_lines_finalizer(con);
+   return R_NilValue;
+}
+
+
+/**
+ * Write text lines to a file
+ *
+ * @param str character vector
+ * @param fname single string, file name
+ * @param encoding single string, output encoding,
+ *    NULL or "" for the default one
+ * @param sep single string, newline separator
+ *
+ * @return NULL
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_write_lines(SEXP str, SEXP fname, SEXP encoding, SEXP sep)
+{
+   PROTECT(str = stri_prepare_arg_string(str, "str"));
+   PROTECT(sep = stri_prepare_arg_string_1(sep, "sep"));
+   const char* fname_val = stri__prepare_arg_fname(fname);
+   const char* encoding_val = stri__prepare_arg_enc(encoding, "encoding", true);
+
+   StriLineWriter* writer = NULL;
+   STRI__ERROR_HANDLER_BEGIN(2)
+   R_len_t str_length = LENGTH(str);
+   StriContainerUTF8 str_cont(str, str_length);
+   StriContainerUTF8 sep_cont(sep, 1);
+   if (sep_cont.isNA(0))
+      throw StriException(MSG__ARG_EXPECTED_NOT_NA, "sep");
+   for (R_len_t i = 0; i < str_length; ++i) {
+      if (str_cont.isNA(i))
+         throw StriException(MSG__ARG_EXPECTED_NOT_NA, "str");
+   }
+
+   const char* sep_s = sep_cont.get(0).c_str();
+   R_len_t sep_n = sep_cont.get(0).length();
+
+   writer = new StriLineWriter(fname_val, encoding_val);
+   if (!writer) throw StriException(MSG__MEM_ALLOC_ERROR);
+   for (R_len_t i = 0; i < str_length; ++i) {
+      writer->write(str_cont.get(i).c_str(), str_cont.get(i).length());
+      writer->write(sep_s, sep_n);
+   }
+   writer->close();
+   delete writer;
+   writer = NULL;
+
+   STRI__UNPROTECT_ALL
+   return R_NilValue;
+   STRI__ERROR_HANDLER_END({
+      if (writer) { delete writer; writer = NULL; }
+   })
+}
@@ -0,0 +1,171 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_files_h
+#define __stri_files_h
+
+#include "stri_stringi.h"
+#include "stri_ucnv.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+
+/**
+ * A read-only memory-mapped file
+ *
+ * The file's contents are paged in by the OS on access,
+ * so reading huge files does not require reserving
+ * memory for a copy of them.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriMappedFile {
+
+   private:
+
+      const char* m_data; // NULL for empty files
+      size_t m_size;
+      size_t m_released;  // pages before this offset have been released
+
+      StriMappedFile(const StriMappedFile&);            // not copyable
+      StriMappedFile& operator=(const StriMappedFile&);
+
+   public:
+
+      StriMappedFile(const char* fname);
+      ~StriMappedFile();
+
+      const char* data() const { return m_data; }
+      size_t size() const { return m_size; }
+
+      void prefetch(size_t from, size_t n) const;
+      void release(size_t upto);
+};
+
+
+/**
+ * Reads consecutive text lines from a file
+ *
+ * Text lines are split at the same newline markers as
+ * in stri_split_lines1 (CR, LF, CR+LF, VT, FF, NEL, LS, PS);
+ * a newline marker at the end of the file does not start
+ * a new line.
+ *
+ * UTF-8 and ASCII files are scanned directly: lines are
+ * returned as pointers to the mapped memory, and only
+ * invalid lines are converted with ICU (which substitutes
+ * the offending bytes). Other encodings are converted with ICU
+ * chunk by chunk.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriLineReader {
+
+   private:
+
+      StriMappedFile m_file;
+      std::string m_encoding; // empty for the default one
+      StriUcnv m_ucnv;
+      int m_mode;             // one of STRI__LINEREADER_*
+
+      size_t m_pos;           // next byte to read
+      bool m_done;            // have all lines been read?
+      bool m_any;             // has any line been read?
+
+      // ICU mode:
+      std::vector<UChar> m_ubuf; // converted chunk
+      size_t m_upos;             // next UChar to read from m_ubuf
+      size_t m_un;               // number of UChars in m_ubuf
+      bool m_flushed;            // has the converter consumed the whole file?
+      bool m_after_cr;           // was the last newline marker a CR?
+      std::vector<UChar> m_uline;
+
+      std::string m_line;        // a converted line
+
+      bool fillBuffer();
+      bool nextICU(const char*& s, R_len_t& n);
+      void setConverted(const UChar* s, size_t n, const char*& out, R_len_t& out_n);
+
+   public:
+
+      StriLineReader(const char* fname, const char* encoding);
+
+      bool next(const char*& s, R_len_t& n);
+
+      /** @return false if there are more lines to read */
+      bool isDone() const { return m_done; }
+
+      void advise();
+};
+
+
+/**
+ * Writes text to a file through a fixed-size buffer
+ *
+ * UTF-8 input is copied as-is if the output encoding is UTF-8,
+ * otherwise it is converted in chunks with a single ICU converter,
+ * so that stateful encodings (and byte order marks) are handled
+ * as if the whole text was converted at once.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriLineWriter {
+
+   private:
+
+      FILE* m_file;
+      std::string m_fname;
+      std::string m_encoding; // empty for the default one
+      StriUcnv m_ucnv;
+      bool m_utf8;            // no conversion needed?
+
+      std::vector<char> m_buf;   // output buffer
+      size_t m_n;                // number of bytes in m_buf
+      std::vector<UChar> m_ubuf; // converted input chunk
+
+      StriLineWriter(const StriLineWriter&);            // not copyable
+      StriLineWriter& operator=(const StriLineWriter&);
+
+      void flushBuffer();
+      void convert(const UChar* s, size_t n, bool flush);
+
+   public:
+
+      StriLineWriter(const char* fname, const char* encoding);
+      ~StriLineWriter();
+
+      void write(const char* s, R_len_t n);
+      void close();
+};
+
+#endif
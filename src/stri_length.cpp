@@ -86,10 +86,23 @@ R_len_t stri__numbytes_max(SEXP str)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH (unless in ASCII)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    lazy StriSubstrings results are not materialized
  */
 SEXP stri_length(SEXP str)
 {
    PROTECT(str = stri_prepare_arg_string(str, "str"));
+   SEXP ret_lazy = stri__substrings_length(str);
+   if (!isNull(ret_lazy)) {
+      UNPROTECT(1);
+      return ret_lazy;
+   }
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, true/*ASCII => O(1)*/,
+      stri_length(str_unique))
 
    STRI__ERROR_HANDLER_BEGIN(1)
 
@@ -231,7 +244,7 @@ SEXP stri_isempty(SEXP str)
 }
 
 
-/** Get width of a single character
+/** Get width of a single character, as determined by ICU character properties
  *
  * inspired by http://www.cl.cam.ac.uk/~mgk25/ucs/wcwidth.c
  *
@@ -240,10 +253,13 @@ SEXP stri_isempty(SEXP str)
  * @version 1.2.1 (Marek Gagolewski, 2018-04-20)
  *    add Variation Selectors support (width 0)
  *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    renamed from stri__width_char, see stri__width_char
+ *
  * @param c code point
  * @return 0, 1, or 2
  */
-int stri__width_char(UChar32 c) {
+static int stri__width_char_icu(UChar32 c) {
    if (c == (UChar32)0x00AD) return 1; /* SOFT HYPHEN  */
    if (c == (UChar32)0x200B) return 0; /* ZERO WIDTH SPACE */
 
@@ -272,11 +288,97 @@ int stri__width_char(UChar32 c) {
 }
 
 
+/* A two-stage lookup table for stri__width_char():
+ * stri__width_table[c >> 8] gives the widths of the 256 code points
+ * in the block that c belongs to, or is NULL if this block has not been
+ * used yet. Blocks are filled on first use, as ICU data may differ
+ * between ICU versions. Blocks of code points of the same width
+ * share one of the constant rows below.
+ */
+#define STRI__WIDTH_BLOCK_BITS 8
+#define STRI__WIDTH_BLOCK_SIZE (1 << STRI__WIDTH_BLOCK_BITS)
+#define STRI__WIDTH_NUM_BLOCKS ((UCHAR_MAX_VALUE+1) >> STRI__WIDTH_BLOCK_BITS)
+static unsigned char stri__width_uniform[3][STRI__WIDTH_BLOCK_SIZE];
+static unsigned char* stri__width_table[STRI__WIDTH_NUM_BLOCKS] = { NULL };
+
+
+/** Fill a block of the lookup table used by stri__width_char
+ *
+ * @param block block index, c >> STRI__WIDTH_BLOCK_BITS
+ * @return the widths of code points in the block
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static const unsigned char* stri__width_fill_block(int block)
+{
+   unsigned char widths[STRI__WIDTH_BLOCK_SIZE];
+   UChar32 c = (UChar32)block << STRI__WIDTH_BLOCK_BITS;
+   bool uniform = true;
+   for (int k=0; k<STRI__WIDTH_BLOCK_SIZE; ++k) {
+      widths[k] = (unsigned char)stri__width_char_icu(c+k);
+      if (widths[k] != widths[0]) uniform = false;
+   }
+
+   unsigned char* row;
+   if (uniform) {
+      row = stri__width_uniform[widths[0]];
+      if (row[0] != widths[0]) memset(row, widths[0], STRI__WIDTH_BLOCK_SIZE);
+   }
+   else {
+      row = new unsigned char[STRI__WIDTH_BLOCK_SIZE];
+      if (!row) throw StriException(MSG__MEM_ALLOC_ERROR);
+      memcpy(row, widths, STRI__WIDTH_BLOCK_SIZE);
+   }
+   stri__width_table[block] = row;
+   return row;
+}
+
+
+/** Release the memory used by stri__width_char's lookup table
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__width_clear_table()
+{
+   for (int i=0; i<STRI__WIDTH_NUM_BLOCKS; ++i) {
+      unsigned char* row = stri__width_table[i];
+      if (row && row != stri__width_uniform[0] && row != stri__width_uniform[1]
+            && row != stri__width_uniform[2])
+         delete [] row;
+      stri__width_table[i] = NULL;
+   }
+}
+
+
+/** Get width of a single character
+ *
+ * Uses a lookup table, see stri__width_char_icu for the rules.
+ *
+ * @param c code point
+ * @return 0, 1, or 2
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+int stri__width_char(UChar32 c) {
+   if (c < 0x80) // ASCII: Cc (width 0) or Na (width 1)
+      return (c >= 0x20 && c < 0x7F) ? 1 : 0;
+   if (c > UCHAR_MAX_VALUE)
+      return stri__width_char_icu(c);
+
+   const unsigned char* row = stri__width_table[c >> STRI__WIDTH_BLOCK_BITS];
+   if (!row) row = stri__width_fill_block(c >> STRI__WIDTH_BLOCK_BITS);
+   return row[c & (STRI__WIDTH_BLOCK_SIZE-1)];
+}
+
+
 /** Get width of a single UTF-8 string
  *
  * @param str_cur_s string
  * @param str_cur_n number of bytes in str_cur_s
  * @return width
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    ASCII fast path
  */
 int stri__width_string(const char* str_cur_s, int str_cur_n) {
    int cur_width = 0;
@@ -284,6 +386,13 @@ int stri__width_string(const char* str_cur_s, int str_cur_n) {
    UChar32 c;
    R_len_t j = 0;
    while (j < str_cur_n) {
+      unsigned char b = (unsigned char)str_cur_s[j];
+      if (b < 0x80) { // ASCII: Cc (width 0) or Na (width 1)
+         cur_width += (b >= 0x20 && b < 0x7F);
+         ++j;
+         continue;
+      }
+
       U8_NEXT(str_cur_s, j, str_cur_n, c);
       if (c < 0)
          throw StriException(MSG__INVALID_UTF8);
@@ -301,10 +410,15 @@ int stri__width_string(const char* str_cur_s, int str_cur_n) {
   * @return integer vector
   *
   * @version 0.5-1 (Marek Gagolewski, 2015-04-22)
+  *
+  * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+  *    STRI__UNIQUE_DISPATCH
   */
 SEXP stri_width(SEXP str)
 {
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_width(str_unique))
 
    STRI__ERROR_HANDLER_BEGIN(1)
    R_len_t str_n = LENGTH(str);
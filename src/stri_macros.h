@@ -63,6 +63,31 @@
       }                                                                                          \
 
 
+/* Evaluate a function that is vectorized with respect to str only
+ * (a pure per-element map) on the distinct CHARSXPs in str only
+ * (this is done only if str has many repeated strings,
+ * see stri__unique_strings()); the results are then
+ * scattered back to the positions of all the duplicates.
+ * To be used after str has been prepared & PROTECTed,
+ * but before STRI__ERROR_HANDLER_BEGIN.
+ * `call` should refer to str_unique instead of str.
+ */
+#define STRI__UNIQUE_DISPATCH(str, str_unique, nprotect, trivial_ascii, call)     \
+   {                                                                             \
+      SEXP stri__unique_dispatch = stri__unique_strings((str), (trivial_ascii)); \
+      if (!isNull(stri__unique_dispatch)) {                                      \
+         PROTECT(stri__unique_dispatch);                                         \
+         SEXP str_unique = VECTOR_ELT(stri__unique_dispatch, 0);                 \
+         SEXP stri__unique_ret;                                                  \
+         PROTECT(stri__unique_ret = (call));                                     \
+         stri__unique_ret = stri__unique_expand(stri__unique_ret,                \
+            VECTOR_ELT(stri__unique_dispatch, 1));                               \
+         UNPROTECT((nprotect)+2);                                                \
+         return stri__unique_ret;                                                \
+      }                                                                          \
+   }                                                                             \
+
+
 #define STRI__GET_INT32_BE(input, index) \
    uint32_t(((uint8_t*)input)[index+0] << 24 | ((uint8_t*)input)[index+1] << 16 | ((uint8_t*)input)[index+2] << 8 | ((uint8_t*)input)[index+3])
 
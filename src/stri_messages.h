@@ -283,4 +283,25 @@
 #define MSG__MEM_ALLOC_ERROR \
    "memory allocation error"
 
+#define MSG__FILE_OPEN_ERROR \
+   "cannot open file `%.512s`"
+
+#define MSG__FILE_WRITE_ERROR \
+   "cannot write to file `%.512s`"
+
+#define MSG__FILE_MAP_ERROR \
+   "cannot memory-map file `%.512s`"
+
+#define MSG__LINE_TOO_LONG \
+   "text lines longer than 2^31-1 bytes are not supported"
+
+#define MSG__EMBEDDED_NUL \
+   "embedded nul in a text line"
+
+#define MSG__ARG_EXPECTED_LINE_READER \
+   "argument `%s` should be an object returned by stri_read_lines_open()"
+
+#define MSG__LINE_READER_CLOSED \
+   "the line reader has already been closed"
+
 #endif
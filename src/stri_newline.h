@@ -0,0 +1,162 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_newline_h
+#define __stri_newline_h
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define STRI__NEWLINE_SSE2
+#include <emmintrin.h>
+#else
+#include <stdint.h>
+#endif
+
+
+/* Newline markers in UTF-8, as in stri_split_lines1
+ * (Unicode Newline Guidelines, see http://www.unicode.org/reports/tr13/):
+ *    LF (0A), VT (0B), FF (0C), CR (0D), CR+LF (0D 0A),
+ *    NEL (C2 85), LS (E2 80 A8), PS (E2 80 A9).
+ *
+ * A byte is a candidate for the first byte of a marker iff it is
+ * in 0A..0D, C2, or E2. Such bytes are searched for in blocks
+ * of 32 bytes (with SSE2 if available, 8 bytes at a time otherwise);
+ * the multibyte markers are confirmed only at the candidate positions.
+ *
+ * Note that C2 and E2 are never continuation bytes, so a candidate
+ * is always at a code point boundary (ICU's U8_NEXT never consumes
+ * such a byte as a part of another, possibly ill-formed, sequence).
+ */
+#define STRI__NEWLINE_BLOCK 32
+
+
+#ifdef STRI__NEWLINE_SSE2
+/** Get the positions of the candidate bytes in a 16-byte block
+ *
+ * @param v 16 bytes
+ * @return bit mask
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline unsigned int stri__newline_candidates(__m128i v)
+{
+   __m128i x = _mm_sub_epi8(v, _mm_set1_epi8(0x0A));  // 0A..0D -> 0..3
+   __m128i m = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(3)), x);
+   m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8((char)0xC2)));
+   m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8((char)0xE2)));
+   return (unsigned int)_mm_movemask_epi8(m);
+}
+#else
+/** Check if an 8-byte word might include a candidate byte
+ *
+ * @param x 8 bytes
+ * @return false if there are definitely no candidates
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline bool stri__newline_candidates(uint64_t x)
+{
+   const uint64_t ones = (uint64_t)0x0101010101010101ULL;
+   const uint64_t high = (uint64_t)0x8080808080808080ULL;
+   uint64_t c2 = x^(ones*0xC2);
+   uint64_t e2 = x^(ones*0xE2);
+   return (((x-ones*0x0E) & ~x) |     // some byte < 0x0E
+           ((c2-ones) & ~c2) |        // some byte == 0xC2
+           ((e2-ones) & ~e2)) & high; // some byte == 0xE2
+}
+#endif
+
+
+/** Find the next newline marker in a UTF-8 string
+ *
+ * @param s string
+ * @param j index of the first byte to examine
+ * @param n number of bytes in s
+ * @param next [out] index of the first byte after the marker
+ *    (CR+LF is a single marker); n if there is no marker
+ * @param unicode whether NEL, LS, and PS are markers too
+ * @return index of the first byte of the marker; n if there is no marker
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline size_t stri__find_newline(const char* s, size_t j, size_t n, size_t& next,
+   bool unicode=true)
+{
+   const unsigned char* u = (const unsigned char*)s;
+   while (j < n) {
+      // skip whole blocks with no candidates
+      while (j+STRI__NEWLINE_BLOCK <= n) {
+#ifdef STRI__NEWLINE_SSE2
+         unsigned int mask = stri__newline_candidates(_mm_loadu_si128((const __m128i*)(u+j)))
+            | (stri__newline_candidates(_mm_loadu_si128((const __m128i*)(u+j+16))) << 16);
+         if (mask) {
+            while (!(mask & 1)) { mask >>= 1; ++j; }
+            break;
+         }
+#else
+         uint64_t x[4];
+         memcpy(x, u+j, sizeof(x));
+         if (stri__newline_candidates(x[0]) || stri__newline_candidates(x[1]) ||
+               stri__newline_candidates(x[2]) || stri__newline_candidates(x[3]))
+            break; // the candidate is found below
+#endif
+         j += STRI__NEWLINE_BLOCK;
+      }
+
+      // examine the bytes one by one up to the end of the current block
+      size_t jend = (j+STRI__NEWLINE_BLOCK <= n) ? j+STRI__NEWLINE_BLOCK : n;
+      for (; j < jend; ++j) {
+         unsigned char b = u[j];
+         if (b >= 0x0A && b <= 0x0D) {
+            next = (b == 0x0D && j+1 < n && u[j+1] == 0x0A) ? j+2 : j+1;
+            return j;
+         }
+         else if (!unicode || (b != 0xC2 && b != 0xE2))
+            continue;
+         else if (b == 0xC2 && j+1 < n && u[j+1] == 0x85) { // NEL
+            next = j+2;
+            return j;
+         }
+         else if (b == 0xE2 && j+2 < n && u[j+1] == 0x80 &&
+               (u[j+2] == 0xA8 || u[j+2] == 0xA9)) { // LS, PS
+            next = j+3;
+            return j;
+         }
+      }
+   }
+   next = n;
+   return n;
+}
+
+#endif
@@ -0,0 +1,260 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "stri_stringi.h"
+#include "stri_occurrences.h"
+#include "stri_substrings.h"
+
+
+/** Add (start, end) pairs for the ith string
+ *
+ * @param i index
+ * @param occurrences pairs to add
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriOccurrences::push(R_len_t i,
+   const std::deque< std::pair<R_len_t, R_len_t> >& occurrences)
+{
+   std::deque< std::pair<R_len_t, R_len_t> >::const_iterator iter;
+   for (iter = occurrences.begin(); iter != occurrences.end(); ++iter)
+      push(i, iter->first, iter->second);
+}
+
+
+/** Get the number of columns of the flattened result
+ *
+ * @return maximal number of pairs per row (at least 1)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+R_len_t StriOccurrences::getMaxNumCols() const
+{
+   R_len_t ncol = 1;
+   for (R_len_t i = 0; i < m_n; ++i)
+      if (m_ncol[i] > ncol) ncol = m_ncol[i];
+   return ncol;
+}
+
+
+/** Get the group index of the flattened result
+ *
+ * @return integer vector of length n+1, (unprotected)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP StriOccurrences::getOffsets() const
+{
+   SEXP ret;
+   PROTECT(ret = Rf_allocVector(INTSXP, m_n+1));
+   int* ret_tab = INTEGER(ret);
+   ret_tab[0] = 0;
+   for (R_len_t i = 0; i < m_n; ++i)
+      ret_tab[i+1] = ret_tab[i] + m_count[i]/m_ncol[i];
+   UNPROTECT(1);
+   return ret;
+}
+
+
+/** Set an element of a character result
+ *
+ * @param data STRSXP or StriSubstrings' INTSXP
+ * @param data_sub StriSubstrings wrapper of \code{data}
+ * @param idx element index
+ * @param i string index
+ * @param k pair index
+ * @param cg_missing CHARSXP for capture groups that did not participate
+ *    in the match; if not NA, \code{data} must be a STRSXP
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriOccurrences::setElement(SEXP data, StriSubstrings& data_sub,
+   R_len_t idx, R_len_t i, R_len_t k, SEXP cg_missing) const
+{
+   if (m_start[k] == NA_INTEGER)
+      data_sub.setNA(idx);
+   else if (m_start[k] < 0 || m_end[k] < 0) {
+      if (cg_missing == NA_STRING)
+         data_sub.setNA(idx);
+      else
+         SET_STRING_ELT(data, idx, cg_missing);
+   }
+   else
+      data_sub.set(idx, i, m_start[k], m_end[k]-m_start[k]);
+}
+
+
+/** Convert the occurrences to substrings
+ *
+ * @param str character vector
+ * @param str_cont \code{str}'s contents; the pairs are
+ *    UTF-8 byte indices (from, to) into them
+ * @param flatten if true, a single vector is returned,
+ *    otherwise, a list with one vector per string
+ * @param matrix whether the vectors should be matrices with ncol columns
+ * @param cg_missing CHARSXP to be used for capture groups that
+ *    did not participate in a match
+ *
+ * @return character vector, character matrix, or a list (unprotected)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP StriOccurrences::toCharacter(SEXP str, const StriContainerUTF8& str_cont,
+   bool flatten, bool matrix, SEXP cg_missing) const
+{
+   // non-NA cg_missing cannot be represented by a lazy substring
+   bool eager = (cg_missing != NA_STRING);
+   SEXP ret;
+
+   if (flatten) {
+      R_len_t ncol = getMaxNumCols();
+      R_len_t nrow = 0;
+      for (R_len_t i = 0; i < m_n; ++i)
+         nrow += m_count[i]/m_ncol[i];
+
+      PROTECT(ret = (eager)?Rf_allocVector(STRSXP, nrow*ncol)
+         :StriSubstrings::alloc(str, str_cont, nrow*ncol));
+      StriSubstrings ret_sub(ret, str, str_cont);
+      R_len_t row = 0;
+      for (R_len_t i = 0; i < m_n; ++i) {
+         R_len_t ncol_cur = m_ncol[i];
+         R_len_t k = m_first[i];
+         for (R_len_t t = 0; t < m_count[i]; t += ncol_cur, ++row) {
+            for (R_len_t c = 0; c < ncol; ++c) {
+               if (c < ncol_cur)
+                  setElement(ret, ret_sub, c*nrow+row, i, k++, cg_missing);
+               else
+                  ret_sub.setNA(c*nrow+row); // fill up
+            }
+         }
+      }
+
+      PROTECT(ret = ret_sub.toR());
+      if (matrix) {
+         SEXP dim;
+         PROTECT(dim = Rf_allocVector(INTSXP, 2));
+         INTEGER(dim)[0] = nrow;
+         INTEGER(dim)[1] = ncol;
+         Rf_setAttrib(ret, R_DimSymbol, dim);
+         UNPROTECT(1);
+      }
+
+      SEXP offsets;
+      PROTECT(offsets = getOffsets());
+      Rf_setAttrib(ret, Rf_install("offsets"), offsets);
+      UNPROTECT(3);
+      return ret;
+   }
+
+   PROTECT(ret = Rf_allocVector(VECSXP, m_n));
+   for (R_len_t i = 0; i < m_n; ++i) {
+      R_len_t ncol = m_ncol[i];
+      R_len_t k = m_first[i];
+      R_len_t nrow = m_count[i]/ncol;
+
+      SEXP ans;
+      PROTECT(ans = (eager)?Rf_allocVector(STRSXP, m_count[i])
+         :StriSubstrings::alloc(str, str_cont, m_count[i], i));
+      StriSubstrings ans_sub(ans, str, str_cont);
+      for (R_len_t t = 0; t < m_count[i]; ++t, ++k)
+         setElement(ans, ans_sub, (t%ncol)*nrow+t/ncol, i, k, cg_missing);
+
+      PROTECT(ans = ans_sub.toR());
+      if (matrix) {
+         SEXP dim;
+         PROTECT(dim = Rf_allocVector(INTSXP, 2));
+         INTEGER(dim)[0] = nrow;
+         INTEGER(dim)[1] = ncol;
+         Rf_setAttrib(ans, R_DimSymbol, dim);
+         UNPROTECT(1);
+      }
+      SET_VECTOR_ELT(ret, i, ans);
+      UNPROTECT(2);
+   }
+   UNPROTECT(1);
+   return ret;
+}
+
+
+/** Convert the occurrences to start-end matrices
+ *
+ * The pairs should already be 1-based code point indices.
+ *
+ * @param flatten if true, a single matrix is returned,
+ *    otherwise, a list with one matrix per string
+ *
+ * @return integer matrix or a list (unprotected)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP StriOccurrences::toInteger(bool flatten) const
+{
+   SEXP ret;
+
+   if (flatten) {
+      R_len_t nrow = size();
+      PROTECT(ret = Rf_allocMatrix(INTSXP, nrow, 2));
+      int* ret_tab = INTEGER(ret);
+      R_len_t row = 0;
+      for (R_len_t i = 0; i < m_n; ++i) {
+         for (R_len_t t = 0, k = m_first[i]; t < m_count[i]; ++t, ++k, ++row) {
+            ret_tab[row]      = m_start[k];
+            ret_tab[row+nrow] = m_end[k];
+         }
+      }
+      stri__locate_set_dimnames_matrix(ret);
+
+      SEXP offsets;
+      PROTECT(offsets = getOffsets());
+      Rf_setAttrib(ret, Rf_install("offsets"), offsets);
+      UNPROTECT(2);
+      return ret;
+   }
+
+   PROTECT(ret = Rf_allocVector(VECSXP, m_n));
+   for (R_len_t i = 0; i < m_n; ++i) {
+      R_len_t nrow = m_count[i];
+      R_len_t k = m_first[i];
+      SEXP ans;
+      PROTECT(ans = Rf_allocMatrix(INTSXP, nrow, 2));
+      int* ans_tab = INTEGER(ans);
+      for (R_len_t t = 0; t < nrow; ++t, ++k) {
+         ans_tab[t]      = m_start[k];
+         ans_tab[t+nrow] = m_end[k];
+      }
+      SET_VECTOR_ELT(ret, i, ans);
+      UNPROTECT(1);
+   }
+   stri__locate_set_dimnames_list(ret);
+   UNPROTECT(1);
+   return ret;
+}
@@ -0,0 +1,135 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_occurrences_h
+#define __stri_occurrences_h
+
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+#include <deque>
+#include <utility>
+#include <vector>
+
+class StriSubstrings;
+
+
+/**
+ * Occurrences (matches, fields) of a pattern in each string of a vector
+ *
+ * The *_all search functions gather the (start, end) index pairs
+ * for all the strings in a single buffer first and only then convert
+ * them to an R object: either a list with a separate vector
+ * (or matrix) for each string, or -- if flatten=TRUE -- a single
+ * vector (or matrix) with all the occurrences. In the latter case,
+ * the result has the "offsets" attribute, a CSR-like group index:
+ * rows offsets[i]+1, ..., offsets[i+1] correspond to the i-th string.
+ * No per-string R objects are created then at all.
+ *
+ * The strings may be visited in any order (e.g., vectorize_next()'s
+ * one when the pattern vector is recycled), but all the pairs
+ * for a single string must be pushed consecutively.
+ *
+ * Each row consists of ncol consecutive (start, end) pairs,
+ * where ncol may vary from string to string (see setNumCols).
+ * A pair of NA_INTEGERs denotes a missing value, and a negative
+ * start -- a capture group that did not participate in the match.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriOccurrences {
+
+   private:
+
+      R_len_t m_n;                  // number of strings
+      std::vector<int> m_start;     // all the pairs, string by string
+      std::vector<int> m_end;
+      std::vector<R_len_t> m_first; // index of the first pair for each string
+      std::vector<R_len_t> m_count; // number of pairs for each string
+      std::vector<R_len_t> m_ncol;  // number of pairs per row for each string
+
+      R_len_t getMaxNumCols() const;
+      SEXP getOffsets() const;
+      void setElement(SEXP data, StriSubstrings& data_sub,
+         R_len_t idx, R_len_t i, R_len_t k, SEXP cg_missing) const;
+
+   public:
+
+      StriOccurrences(R_len_t n, R_len_t ncol=1) :
+         m_n(n), m_first(n, 0), m_count(n, 0), m_ncol(n, ncol) { }
+
+      /** @return total number of (start, end) pairs */
+      inline R_len_t size() const { return (R_len_t)m_start.size(); }
+
+      /** Set the number of (start, end) pairs per row for the ith string
+       *
+       * @param i index
+       * @param ncol number of columns
+       */
+      inline void setNumCols(R_len_t i, R_len_t ncol) { m_ncol[i] = ncol; }
+
+      /** Add a (start, end) pair for the ith string
+       *
+       * @param i index
+       * @param start start index
+       * @param end end index
+       */
+      inline void push(R_len_t i, int start, int end) {
+         if (m_count[i] == 0) m_first[i] = size();
+         m_start.push_back(start);
+         m_end.push_back(end);
+         ++m_count[i];
+      }
+
+      /** Add missing values for the ith string
+       *
+       * @param i index
+       * @param nrow number of rows of NAs
+       */
+      inline void pushNA(R_len_t i, R_len_t nrow=1) {
+         for (R_len_t k = 0; k < nrow*m_ncol[i]; ++k)
+            push(i, NA_INTEGER, NA_INTEGER);
+      }
+
+      void push(R_len_t i, const std::deque< std::pair<R_len_t, R_len_t> >& occurrences);
+
+      /** @return pointer to the start indices, from the kth pair onwards */
+      inline int* getStarts(R_len_t k) { return &m_start[k]; }
+
+      /** @return pointer to the end indices, from the kth pair onwards */
+      inline int* getEnds(R_len_t k) { return &m_end[k]; }
+
+      SEXP toCharacter(SEXP str, const StriContainerUTF8& str_cont,
+         bool flatten, bool matrix=false, SEXP cg_missing=NA_STRING) const;
+      SEXP toInteger(bool flatten) const;
+};
+
+#endif
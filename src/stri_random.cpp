@@ -35,9 +35,86 @@
 #include "stri_container_integer.h"
 #include "stri_string8buf.h"
 #include <vector>
+#include <map>
+#include <algorithm>
 #include "stri_container_charclass.h"
 
 
+/** sets with at most that many code points are stored as flat arrays */
+#define STRI__RAND_SAMPLER_FLAT_MAX 65536
+
+
+/**
+ * Fast access to the code points in a UnicodeSet by index
+ *
+ * UnicodeSet::charAt() walks the list of ranges. Here,
+ * small sets are flattened to an array of code points, and for
+ * larger ones the cumulative range sizes are binary-searched.
+ * Surrogate code points (U+D800..U+DFFF) are excluded,
+ * as they cannot be represented in valid UTF-8, and so is U+0000,
+ * which cannot occur in R strings.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriRandSampler {
+
+   private:
+
+      std::vector<UChar32> m_chars;  // all code points (small sets only)
+      std::vector<UChar32> m_starts; // range starts (large sets only)
+      std::vector<int32_t> m_cumsizes; // number of code points in ranges 0..r
+      int32_t m_count;               // number of code points
+      int32_t m_size;                // UnicodeSet::size() (strings included)
+
+   public:
+
+      StriRandSampler(const UnicodeSet& uset0)
+      {
+         UnicodeSet uset; // uset0 is frozen, so is its copy
+         uset.addAll(uset0);
+         uset.remove((UChar32)0xD800, (UChar32)0xDFFF); // e.g., [^a] includes surrogates
+         uset.remove((UChar32)0x0000);
+         int32_t nranges = uset.getRangeCount();
+         m_size = uset.size();
+         m_count = 0;
+         for (int32_t r = 0; r < nranges; ++r)
+            m_count += uset.getRangeEnd(r)-uset.getRangeStart(r)+1;
+
+         if (m_count <= STRI__RAND_SAMPLER_FLAT_MAX) {
+            m_chars.reserve(m_count);
+            for (int32_t r = 0; r < nranges; ++r)
+               for (UChar32 c = uset.getRangeStart(r); c <= uset.getRangeEnd(r); ++c)
+                  m_chars.push_back(c);
+         }
+         else {
+            m_starts.resize(nranges);
+            m_cumsizes.resize(nranges);
+            int32_t cumsize = 0;
+            for (int32_t r = 0; r < nranges; ++r) {
+               m_starts[r] = uset.getRangeStart(r);
+               cumsize += uset.getRangeEnd(r)-uset.getRangeStart(r)+1;
+               m_cumsizes[r] = cumsize;
+            }
+         }
+      }
+
+      /** @return the size of the set, including the strings in it */
+      inline int32_t size() const { return m_size; }
+
+      /** @return idx-th code point (as UnicodeSet::charAt) or -1 */
+      inline UChar32 charAt(int32_t idx) const
+      {
+         if (idx < 0 || idx >= m_count)
+            return -1;
+         if (!m_chars.empty())
+            return m_chars[idx];
+         size_t r = std::upper_bound(m_cumsizes.begin(), m_cumsizes.end(), idx)
+            - m_cumsizes.begin();
+         return m_starts[r]+(idx-(r > 0 ? m_cumsizes[r-1] : 0));
+      }
+};
+
+
 /** Generate random permutations of code points in each string
  *
  * @param str character vector
@@ -143,6 +220,9 @@ SEXP stri_rand_shuffle(SEXP str)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriRandSampler, one per distinct pattern; write ASCII directly
  */
 SEXP stri_rand_strings(SEXP n, SEXP length, SEXP pattern)
 {
@@ -174,6 +254,22 @@ SEXP stri_rand_strings(SEXP n, SEXP length, SEXP pattern)
    StriContainerCharClass pattern_cont(pattern, max(n_val, pattern_len));
    StriContainerInteger   length_cont(length, max(n_val, length_len));
 
+   // one sampler per distinct pattern (equal strings share a CHARSXP)
+   std::vector<StriRandSampler> samplers;
+   std::vector<R_len_t> sampler_idx(pattern_len, -1);
+   std::map<SEXP, R_len_t> sampler_map;
+   for (R_len_t i=0; i<pattern_len; ++i) {
+      if (pattern_cont.isNA(i)) continue;
+      SEXP p = STRING_ELT(pattern, i);
+      std::map<SEXP, R_len_t>::iterator it = sampler_map.find(p);
+      if (it != sampler_map.end())
+         sampler_idx[i] = it->second;
+      else {
+         sampler_idx[i] = sampler_map[p] = (R_len_t)samplers.size();
+         samplers.push_back(StriRandSampler(pattern_cont.get(i).getUnicodeSet()));
+      }
+   }
+
    // get max required bufsize
    int*    length_tab = INTEGER(length);
    R_len_t bufsize = 0;
@@ -197,19 +293,20 @@ SEXP stri_rand_strings(SEXP n, SEXP length, SEXP pattern)
       int length_cur = length_cont.get(i);
       if (length_cur < 0) length_cur = 0;
 
-      const UnicodeSet* uset = &(pattern_cont.get(i));
-      int32_t uset_size = uset->size();
+      const StriRandSampler& sampler = samplers[sampler_idx[i%pattern_len]];
+      int32_t uset_size = sampler.size(); // as in 0.2-1, strings are counted too
 
       // generate string:
       R_len_t j = 0;
-      UBool err = FALSE;
       for (R_len_t k=0; k<length_cur; ++k) {
          int32_t idx = (int32_t)floor(unif_rand()*(double)uset_size); /* 0..uset_size-1 */
-         UChar32 c = uset->charAt(idx);
+         UChar32 c = sampler.charAt(idx);
          if (c < 0) throw StriException(MSG__INTERNAL_ERROR);
 
-         U8_APPEND((uint8_t*)bufdata, j, bufsize, c, err);
-         if (err) throw StriException(MSG__INTERNAL_ERROR);
+         if (c < 0x80)
+            bufdata[j++] = (char)c;
+         else
+            U8_APPEND_UNSAFE(bufdata, j, c); // bufsize is sufficient, no surrogates
       }
       SET_STRING_ELT(ret, i, Rf_mkCharLenCE(bufdata, j, CE_UTF8));
    }
@@ -54,10 +54,15 @@
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
  */
 SEXP stri_reverse(SEXP str)
 {
    PROTECT(str = stri_prepare_arg_string(str, "str"));    // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_reverse(str_unique))
 
    STRI__ERROR_HANDLER_BEGIN(1)
    R_len_t str_len = LENGTH(str);
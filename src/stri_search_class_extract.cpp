@@ -33,6 +33,8 @@
 #include "stri_container_utf8.h"
 #include "stri_container_charclass.h"
 #include "stri_container_logical.h"
+#include "stri_substrings.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -61,6 +63,9 @@ using namespace std;
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-04)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriSubstrings (lazy results)
  */
 SEXP stri__extract_firstlast_charclass(SEXP str, SEXP pattern, bool first)
 {
@@ -73,18 +78,19 @@ SEXP stri__extract_firstlast_charclass(SEXP str, SEXP pattern, bool first)
    StriContainerCharClass pattern_cont(pattern, vectorize_length);
 
    SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(STRSXP, vectorize_length));
+   STRI__PROTECT(ret = StriSubstrings::alloc(str, str_cont, vectorize_length));
+   StriSubstrings ret_sub(ret, str, str_cont);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
-      SET_STRING_ELT(ret, i, NA_STRING);
+      ret_sub.setNA(i);
 
       if (str_cont.isNA(i) || pattern_cont.isNA(i))
          continue;
 
-      const UnicodeSet* pattern_cur = &pattern_cont.get(i);
+      const StriCharClass* pattern_cur = &pattern_cont.get(i);
       R_len_t     str_cur_n = str_cont.get(i).length();
       const char* str_cur_s = str_cont.get(i).c_str();
       R_len_t j, jlast;
@@ -96,8 +102,7 @@ SEXP stri__extract_firstlast_charclass(SEXP str, SEXP pattern, bool first)
             if (chr < 0) // invalid utf-8 sequence
                throw StriException(MSG__INVALID_UTF8);
             if (pattern_cur->contains(chr)) {
-               SET_STRING_ELT(ret, i,
-                  Rf_mkCharLenCE(str_cur_s+jlast, j-jlast, CE_UTF8));
+               ret_sub.set(i, i, jlast, j-jlast);
                break; // that's enough for first
             }
             jlast = j;
@@ -109,8 +114,7 @@ SEXP stri__extract_firstlast_charclass(SEXP str, SEXP pattern, bool first)
             if (chr < 0) // invalid utf-8 sequence
                throw StriException(MSG__INVALID_UTF8);
             if (pattern_cur->contains(chr)) {
-               SET_STRING_ELT(ret, i,
-                  Rf_mkCharLenCE(str_cur_s+j, jlast-j, CE_UTF8));
+               ret_sub.set(i, i, j, jlast-j);
                break; // that's enough for last
             }
             jlast = j;
@@ -118,6 +122,7 @@ SEXP stri__extract_firstlast_charclass(SEXP str, SEXP pattern, bool first)
       }
    }
 
+   STRI__PROTECT(ret = ret_sub.toR());
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
@@ -192,11 +197,15 @@ SEXP stri_extract_last_charclass(SEXP str, SEXP pattern)
  *
  * @version 0.4-1 (Marek Gagolewski, 2014-12-04)
  *    allow `simplify=NA`
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_extract_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP simplify, SEXP omit_no_match)
+SEXP stri_extract_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP simplify, SEXP omit_no_match, SEXP flatten)
 {
    bool merge_cur = stri__prepare_arg_logical_1_notNA(merge, "merge");
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(simplify = stri_prepare_arg_logical_1(simplify, "simplify"));
    PROTECT(str = stri_prepare_arg_string(str, "str"));
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern"));
@@ -206,16 +215,14 @@ SEXP stri_extract_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP simplif
    STRI__ERROR_HANDLER_BEGIN(3)
    StriContainerUTF8 str_cont(str, vectorize_length);
    StriContainerCharClass pattern_cont(pattern, vectorize_length);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       if (pattern_cont.isNA(i) || str_cont.isNA(i)) {
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(1));
+         ret_occ.pushNA(i);
          continue;
       }
 
@@ -228,29 +235,20 @@ SEXP stri_extract_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP simplif
          false /* byte-based indices */
       );
 
-      R_len_t noccurrences = (R_len_t)occurrences.size();
-      if (noccurrences == 0) {
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(omit_no_match1?0:1));
-         continue;
-      }
-
-      SEXP cur_res;
-      STRI__PROTECT(cur_res = Rf_allocVector(STRSXP, noccurrences));
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t f = 0; iter != occurrences.end(); ++iter, ++f) {
-         pair<R_len_t, R_len_t> curo = *iter;
-         SET_STRING_ELT(cur_res, f,
-            Rf_mkCharLenCE(str_cur_s+curo.first, curo.second-curo.first, CE_UTF8));
-      }
-      SET_VECTOR_ELT(ret, i, cur_res);
-      STRI__UNPROTECT(1)
+      if (occurrences.size() == 0)
+         ret_occ.pushNA(i, omit_no_match1?0:1);
+      else
+         ret_occ.push(i, occurrences);
    }
 
-   if (LOGICAL(simplify)[0] == NA_LOGICAL) {
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toCharacter(str, str_cont, flatten1));
+
+   if (!flatten1 && LOGICAL(simplify)[0] == NA_LOGICAL) {
       STRI__PROTECT(ret = stri_list2matrix(ret, Rf_ScalarLogical(TRUE),
          stri__vector_NA_strings(1), Rf_ScalarInteger(0)))
    }
-   else if (LOGICAL(simplify)[0]) {
+   else if (!flatten1 && LOGICAL(simplify)[0]) {
       STRI__PROTECT(ret = stri_list2matrix(ret, Rf_ScalarLogical(TRUE),
          stri__vector_empty_strings(1), Rf_ScalarInteger(0)))
    }
@@ -34,6 +34,7 @@
 #include "stri_container_utf8.h"
 #include "stri_container_charclass.h"
 #include "stri_container_logical.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -89,7 +90,7 @@ SEXP stri__locate_firstlast_charclass(SEXP str, SEXP pattern, bool first)
       if (str_cont.isNA(i) || pattern_cont.isNA(i))
          continue;
 
-      const UnicodeSet* pattern_cur = &pattern_cont.get(i);
+      const StriCharClass* pattern_cur = &pattern_cont.get(i);
       R_len_t     str_cur_n = str_cont.get(i).length();
       const char* str_cur_s = str_cont.get(i).c_str();
       R_len_t j;
@@ -180,10 +181,14 @@ SEXP stri_locate_last_charclass(SEXP str, SEXP pattern)
  *
  * @version 0.4-1 (Marek Gagolewski, 2014-11-27)
  *    FR #117: omit_no_match arg added
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_locate_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP omit_no_match)
+SEXP stri_locate_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP omit_no_match, SEXP flatten)
 {
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
       bool merge_cur = stri__prepare_arg_logical_1_notNA(merge, "merge");
    PROTECT(str     = stri_prepare_arg_string(str, "str"));
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern"));
@@ -193,16 +198,14 @@ SEXP stri_locate_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP omit_no_
    STRI__ERROR_HANDLER_BEGIN(2)
    StriContainerUTF8 str_cont(str, vectorize_length);
    StriContainerCharClass pattern_cont(pattern, vectorize_length);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       if (pattern_cont.isNA(i) || str_cont.isNA(i)) {
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(1, 2));
+         ret_occ.pushNA(i);
          continue;
       }
 
@@ -213,26 +216,20 @@ SEXP stri_locate_all_charclass(SEXP str, SEXP pattern, SEXP merge, SEXP omit_no_
          true /* code point-based indices */
       );
 
-      R_len_t noccurrences = (R_len_t)occurrences.size();
-      if (noccurrences == 0) {
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(omit_no_match1?0:1, 2));
+      if (occurrences.size() == 0) {
+         ret_occ.pushNA(i, omit_no_match1?0:1);
          continue;
       }
 
-      SEXP cur_res;
-      STRI__PROTECT(cur_res = Rf_allocMatrix(INTSXP, noccurrences, 2));
-      int* cur_res_int = INTEGER(cur_res);
       deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t f = 0; iter != occurrences.end(); ++iter, ++f) {
+      for (; iter != occurrences.end(); ++iter) {
          pair<R_len_t, R_len_t> curoccur = *iter;
-         cur_res_int[f] = curoccur.first+1; // 0-based => 1-based
-         cur_res_int[f+noccurrences] = curoccur.second;
+         ret_occ.push(i, curoccur.first+1, curoccur.second); // 0-based => 1-based
       }
-      SET_VECTOR_ELT(ret, i, cur_res);
-      STRI__UNPROTECT(1)
    }
 
-   stri__locate_set_dimnames_list(ret);
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toInteger(flatten1));
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
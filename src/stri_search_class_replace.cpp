@@ -198,8 +198,6 @@ SEXP stri__replace_all_charclass_no_vectorize_all(SEXP str, SEXP pattern, SEXP r
    StriContainerUTF8 replacement_cont(replacement, pattern_n);
    StriContainerCharClass pattern_cont(pattern, pattern_n);
 
-   String8buf buf(0); // @TODO: calculate buf len a priori?
-
    for (R_len_t i = 0; i<pattern_n; ++i)
    {
       if (pattern_cont.isNA(i)) {
@@ -207,6 +205,7 @@ SEXP stri__replace_all_charclass_no_vectorize_all(SEXP str, SEXP pattern, SEXP r
          return stri__vector_NA_strings(str_n);
       }
 
+      str_cont.beginPass();
       for (R_len_t j = 0; j<str_n; ++j) {
          if (str_cont.isNA(j)) continue;
 
@@ -229,9 +228,8 @@ SEXP stri__replace_all_charclass_no_vectorize_all(SEXP str, SEXP pattern, SEXP r
 
          R_len_t     replacement_cur_n = replacement_cont.get(i).length();
          R_len_t buf_need = str_cur_n+(R_len_t)occurrences.size()*replacement_cur_n-sumbytes;
-         buf.resize(buf_need, false/*destroy contents*/);
 
-         str_cont.getWritable(j).replaceAllAtPos(buf_need,
+         str_cont.replaceAllAtPos(j, buf_need,
             replacement_cont.get(i).c_str(), replacement_cur_n,
             occurrences);
       }
@@ -320,7 +318,7 @@ SEXP stri__replace_firstlast_charclass(SEXP str, SEXP pattern, SEXP replacement,
          continue;
       }
 
-      const UnicodeSet* pattern_cur = &pattern_cont.get(i);
+      const StriCharClass* pattern_cur = &pattern_cont.get(i);
       R_len_t str_cur_n     = str_cont.get(i).length();
       const char* str_cur_s = str_cont.get(i).c_str();
       R_len_t j, jlast;
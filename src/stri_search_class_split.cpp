@@ -35,6 +35,7 @@
 #include "stri_container_charclass.h"
 #include "stri_container_integer.h"
 #include "stri_container_logical.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -81,11 +82,15 @@ using namespace std;
  *
  * @version 0.4-1 (Marek Gagolewski, 2014-12-04)
  *    allow `simplify=NA`; FR #126: pass n to stri_list2matrix
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
 SEXP stri_split_charclass(SEXP str, SEXP pattern, SEXP n,
-                          SEXP omit_empty, SEXP tokens_only, SEXP simplify)
+                          SEXP omit_empty, SEXP tokens_only, SEXP simplify, SEXP flatten)
 {
    bool tokens_only1 = stri__prepare_arg_logical_1_notNA(tokens_only, "tokens_only");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(str = stri_prepare_arg_string(str, "str"));
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern"));
    PROTECT(n = stri_prepare_arg_integer(n, "n"));
@@ -99,20 +104,18 @@ SEXP stri_split_charclass(SEXP str, SEXP pattern, SEXP n,
    StriContainerInteger   n_cont(n, vectorize_length);
    StriContainerLogical   omit_empty_cont(omit_empty, vectorize_length);
    StriContainerCharClass pattern_cont(pattern, vectorize_length);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       if (str_cont.isNA(i) || pattern_cont.isNA(i) || n_cont.isNA(i)) {
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(1));
+         ret_occ.pushNA(i);
          continue;
       }
 
-      const UnicodeSet* pattern_cur = &pattern_cont.get(i);
+      const StriCharClass* pattern_cur = &pattern_cont.get(i);
       int  n_cur            = n_cont.get(i);
       int  omit_empty_cur   = !omit_empty_cont.isNA(i) && omit_empty_cont.get(i);
 
@@ -120,10 +123,8 @@ SEXP stri_split_charclass(SEXP str, SEXP pattern, SEXP n,
          throw StriException(MSG__EXPECTED_SMALLER, "n");
       else if (n_cur < 0)
          n_cur = INT_MAX;
-      else if (n_cur == 0) {
-         SET_VECTOR_ELT(ret, i, Rf_allocVector(STRSXP, 0));
-         continue;
-      }
+      else if (n_cur == 0)
+         continue; // no fields
       else if (tokens_only1)
          n_cur++; // we need to do one split ahead here
 
@@ -161,25 +162,20 @@ SEXP stri_split_charclass(SEXP str, SEXP pattern, SEXP n,
             fields.pop_back(); // get rid of the remainder
       }
 
-      SEXP ans;
-      STRI__PROTECT(ans = Rf_allocVector(STRSXP, fields.size()));
-
       deque< pair<R_len_t, R_len_t> >::iterator iter = fields.begin();
-      for (k = 0; iter != fields.end(); ++iter, ++k) {
+      for (; iter != fields.end(); ++iter) {
          pair<R_len_t, R_len_t> curoccur = *iter;
          if (curoccur.second == curoccur.first && omit_empty_cont.isNA(i))
-            SET_STRING_ELT(ans, k, NA_STRING);
+            ret_occ.pushNA(i);
          else
-            SET_STRING_ELT(ans, k,
-               Rf_mkCharLenCE(str_cur_s+curoccur.first,
-                           curoccur.second-curoccur.first, CE_UTF8));
+            ret_occ.push(i, curoccur.first, curoccur.second);
       }
-
-      SET_VECTOR_ELT(ret, i, ans);
-      STRI__UNPROTECT(1)
    }
 
-   if (LOGICAL(simplify)[0] == NA_LOGICAL || LOGICAL(simplify)[0]) {
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toCharacter(str, str_cont, flatten1));
+
+   if (!flatten1 && (LOGICAL(simplify)[0] == NA_LOGICAL || LOGICAL(simplify)[0])) {
       R_len_t n_min = 0;
       R_len_t n_length = LENGTH(n);
       int* n_tab = INTEGER(n);
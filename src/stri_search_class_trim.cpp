@@ -84,7 +84,7 @@ SEXP stri__trim_leftright(SEXP str, SEXP pattern, bool left, bool right)
          continue;
       }
 
-      const UnicodeSet* pattern_cur = &pattern_cont.get(i);
+      const StriCharClass* pattern_cur = &pattern_cont.get(i);
       R_len_t     str_cur_n = str_cont.get(i).length();
       const char* str_cur_s = str_cont.get(i).c_str();
       R_len_t jlast1 = 0;
@@ -33,6 +33,8 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_container_bytesearch.h"
+#include "stri_substrings.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -56,6 +58,9 @@ using namespace std;
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *    use StriByteSearchMatcher
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriSubstrings (lazy results)
  */
 SEXP stri__extract_firstlast_fixed(SEXP str, SEXP pattern, SEXP opts_fixed, bool first)
 {
@@ -69,14 +74,15 @@ SEXP stri__extract_firstlast_fixed(SEXP str, SEXP pattern, SEXP opts_fixed, bool
    StriContainerByteSearch pattern_cont(pattern, vectorize_length, pattern_flags);
 
    SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(STRSXP, vectorize_length));
+   STRI__PROTECT(ret = StriSubstrings::alloc(str, str_cont, vectorize_length));
+   StriSubstrings ret_sub(ret, str, str_cont);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       STRI__CONTINUE_ON_EMPTY_OR_NA_STR_PATTERN(str_cont, pattern_cont,
-         SET_STRING_ELT(ret, i, NA_STRING);, SET_STRING_ELT(ret, i, NA_STRING);)
+         ret_sub.setNA(i);, ret_sub.setNA(i);)
 
       StriByteSearchMatcher* matcher = pattern_cont.getMatcher(i);
       matcher->reset(str_cont.get(i).c_str(), str_cont.get(i).length());
@@ -87,15 +93,16 @@ SEXP stri__extract_firstlast_fixed(SEXP str, SEXP pattern, SEXP opts_fixed, bool
          start = matcher->findLast();
       }
       if (start == USEARCH_DONE) {
-         SET_STRING_ELT(ret, i, NA_STRING);
+         ret_sub.setNA(i);
          continue;
       }
 
       len = matcher->getMatchedLength();
 
-      SET_STRING_ELT(ret, i, Rf_mkCharLenCE(str_cont.get(i).c_str()+start, len, CE_UTF8));
+      ret_sub.set(i, i, start, len);
    }
 
+   STRI__PROTECT(ret = ret_sub.toR());
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END({ /* no-op */ })
@@ -161,11 +168,15 @@ SEXP stri_extract_last_fixed(SEXP str, SEXP pattern, SEXP opts_fixed)
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *    use StriByteSearchMatcher
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_extract_all_fixed(SEXP str, SEXP pattern, SEXP simplify, SEXP omit_no_match, SEXP opts_fixed)
+SEXP stri_extract_all_fixed(SEXP str, SEXP pattern, SEXP simplify, SEXP omit_no_match, SEXP flatten, SEXP opts_fixed)
 {
    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed, /*allow_overlap*/true);
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(simplify = stri_prepare_arg_logical_1(simplify, "simplify"));
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern")); // prepare string argument
@@ -174,52 +185,39 @@ SEXP stri_extract_all_fixed(SEXP str, SEXP pattern, SEXP simplify, SEXP omit_no_
    R_len_t vectorize_length = stri__recycling_rule(true, 2, LENGTH(str), LENGTH(pattern));
    StriContainerUTF8 str_cont(str, vectorize_length);
    StriContainerByteSearch pattern_cont(pattern, vectorize_length, pattern_flags);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       STRI__CONTINUE_ON_EMPTY_OR_NA_STR_PATTERN(str_cont, pattern_cont,
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(1));,
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(omit_no_match1?0:1));)
+         ret_occ.pushNA(i);,
+         ret_occ.pushNA(i, omit_no_match1?0:1);)
 
       StriByteSearchMatcher* matcher = pattern_cont.getMatcher(i);
       matcher->reset(str_cont.get(i).c_str(), str_cont.get(i).length());
 
       int start = matcher->findFirst();
-      deque< pair<R_len_t, R_len_t> > occurrences;
-      while (start != USEARCH_DONE) {
-         occurrences.push_back(pair<R_len_t, R_len_t>(start, start+matcher->getMatchedLength()));
-         start = matcher->findNext();
-      }
-
-      R_len_t noccurrences = (R_len_t)occurrences.size();
-      if (noccurrences <= 0) {
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(omit_no_match1?0:1));
+      if (start == USEARCH_DONE) {
+         ret_occ.pushNA(i, omit_no_match1?0:1);
          continue;
       }
 
-      const char* str_cur_s = str_cont.get(i).c_str();
-      SEXP cur_res;
-      STRI__PROTECT(cur_res = Rf_allocVector(STRSXP, noccurrences));
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t j = 0; iter != occurrences.end(); ++iter, ++j) {
-         pair<R_len_t, R_len_t> curo = *iter;
-         SET_STRING_ELT(cur_res, j,
-            Rf_mkCharLenCE(str_cur_s+curo.first, curo.second-curo.first, CE_UTF8));
+      while (start != USEARCH_DONE) {
+         ret_occ.push(i, start, start+matcher->getMatchedLength());
+         start = matcher->findNext();
       }
-      SET_VECTOR_ELT(ret, i, cur_res);
-      STRI__UNPROTECT(1);
    }
 
-   if (LOGICAL(simplify)[0] == NA_LOGICAL) {
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toCharacter(str, str_cont, flatten1));
+
+   if (!flatten1 && LOGICAL(simplify)[0] == NA_LOGICAL) {
       STRI__PROTECT(ret = stri_list2matrix(ret, Rf_ScalarLogical(TRUE),
          stri__vector_NA_strings(1), Rf_ScalarInteger(0)))
    }
-   else if (LOGICAL(simplify)[0]) {
+   else if (!flatten1 && LOGICAL(simplify)[0]) {
       STRI__PROTECT(ret = stri_list2matrix(ret, Rf_ScalarLogical(TRUE),
          stri__vector_empty_strings(1), Rf_ScalarInteger(0)))
    }
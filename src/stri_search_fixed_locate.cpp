@@ -33,6 +33,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8_indexable.h"
 #include "stri_container_bytesearch.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -201,11 +202,15 @@ SEXP stri_locate_last_fixed(SEXP str, SEXP pattern, SEXP opts_fixed)
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *    use StriByteSearchMatcher
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_locate_all_fixed(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts_fixed)
+SEXP stri_locate_all_fixed(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP flatten, SEXP opts_fixed)
 {
    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed, /*allow_overlap*/true);
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(str = stri_prepare_arg_string(str, "str"));
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern"));
 
@@ -213,55 +218,41 @@ SEXP stri_locate_all_fixed(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
    int vectorize_length = stri__recycling_rule(true, 2, LENGTH(str), LENGTH(pattern));
    StriContainerUTF8_indexable str_cont(str, vectorize_length);
    StriContainerByteSearch pattern_cont(pattern, vectorize_length, pattern_flags);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
       i != pattern_cont.vectorize_end();
       i = pattern_cont.vectorize_next(i))
    {
       STRI__CONTINUE_ON_EMPTY_OR_NA_STR_PATTERN(str_cont, pattern_cont,
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(1, 2));,
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(omit_no_match1?0:1, 2));)
+         ret_occ.pushNA(i);,
+         ret_occ.pushNA(i, omit_no_match1?0:1);)
 
       StriByteSearchMatcher* matcher = pattern_cont.getMatcher(i);
       matcher->reset(str_cont.get(i).c_str(), str_cont.get(i).length());
 
       int start = matcher->findFirst();
       if (start == USEARCH_DONE) { // no matches at all
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(omit_no_match1?0:1, 2));
+         ret_occ.pushNA(i, omit_no_match1?0:1);
          continue;
       }
 
-      deque< pair<R_len_t, R_len_t> > occurrences;
+      R_len_t k = ret_occ.size();
       while (start != USEARCH_DONE) {
-         occurrences.push_back(pair<R_len_t, R_len_t>(start, start+matcher->getMatchedLength()));
+         ret_occ.push(i, start, start+matcher->getMatchedLength());
          start = matcher->findNext();
       }
 
-      R_len_t noccurrences = (R_len_t)occurrences.size();
-      SEXP ans;
-      STRI__PROTECT(ans = Rf_allocMatrix(INTSXP, noccurrences, 2));
-      int* ans_tab = INTEGER(ans);
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t j = 0; iter != occurrences.end(); ++iter, ++j) {
-         pair<R_len_t, R_len_t> match = *iter;
-         ans_tab[j]              = match.first;
-         ans_tab[j+noccurrences] = match.second;
-      }
-
       // Adjust UChar index -> UChar32 index (1-2 byte UTF16 to 1 byte UTF32-code points)
-      str_cont.UTF8_to_UChar32_index(i, ans_tab,
-            ans_tab+noccurrences, noccurrences,
+      str_cont.UTF8_to_UChar32_index(i, ret_occ.getStarts(k),
+            ret_occ.getEnds(k), ret_occ.size()-k,
             1, // 0-based index -> 1-based
             0  // end returns position of next character after match
       );
-      SET_VECTOR_ELT(ret, i, ans);
-      STRI__UNPROTECT(1);
    }
 
-   stri__locate_set_dimnames_list(ret);
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toInteger(flatten1));
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END( ;/* do nothing special on error */ )
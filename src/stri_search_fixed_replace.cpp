@@ -297,6 +297,7 @@ SEXP stri__replace_all_fixed_no_vectorize_all(SEXP str, SEXP pattern, SEXP repla
       }
 
       StriByteSearchMatcher* matcher = pattern_cont.getMatcher(i);
+      str_cont.beginPass();
       for (R_len_t j = 0; j<str_n; ++j) {
          if (str_cont.isNA(j)) continue;
          matcher->reset(str_cont.get(j).c_str(), str_cont.get(j).length());
@@ -325,7 +326,7 @@ SEXP stri__replace_all_fixed_no_vectorize_all(SEXP str, SEXP pattern, SEXP repla
          R_len_t buf_need =
             str_cur_n+replacement_cur_n*(R_len_t)occurrences.size()-sumbytes;
 
-         str_cont.getWritable(j).replaceAllAtPos(buf_need,
+         str_cont.replaceAllAtPos(j, buf_need,
             replacement_cont.get(i).c_str(), replacement_cur_n,
             occurrences);
       }
@@ -35,6 +35,7 @@
 #include "stri_container_bytesearch.h"
 #include "stri_container_integer.h"
 #include "stri_container_logical.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -86,12 +87,19 @@ using namespace std;
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *    use StriByteSearchMatcher
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriSubstrings (lazy results)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
 SEXP stri_split_fixed(SEXP str, SEXP pattern, SEXP n,
-                      SEXP omit_empty, SEXP tokens_only, SEXP simplify, SEXP opts_fixed)
+                      SEXP omit_empty, SEXP tokens_only, SEXP simplify, SEXP flatten, SEXP opts_fixed)
 {
    uint32_t pattern_flags = StriContainerByteSearch::getByteSearchFlags(opts_fixed);
    bool tokens_only1 = stri__prepare_arg_logical_1_notNA(tokens_only, "tokens_only");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(simplify = stri_prepare_arg_logical_1(simplify, "simplify"));
    PROTECT(str = stri_prepare_arg_string(str, "str"));
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern"));
@@ -105,38 +113,32 @@ SEXP stri_split_fixed(SEXP str, SEXP pattern, SEXP n,
    StriContainerByteSearch pattern_cont(pattern, vectorize_length, pattern_flags);
    StriContainerInteger n_cont(n, vectorize_length);
    StriContainerLogical omit_empty_cont(omit_empty, vectorize_length);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       if (n_cont.isNA(i)) {
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(1));
+         ret_occ.pushNA(i);
          continue;
       }
       int  n_cur        = n_cont.get(i);
       int  omit_empty_cur   = !omit_empty_cont.isNA(i) && omit_empty_cont.get(i);
 
       STRI__CONTINUE_ON_EMPTY_OR_NA_STR_PATTERN(str_cont, pattern_cont,
-         SET_VECTOR_ELT(ret, i, stri__vector_NA_strings(1));,
-         SET_VECTOR_ELT(ret, i,
-            (omit_empty_cont.isNA(i))?stri__vector_NA_strings(1):
-            stri__vector_empty_strings((omit_empty_cur || n_cur == 0)?0:1));)
+         ret_occ.pushNA(i);,
+         if (omit_empty_cont.isNA(i)) ret_occ.pushNA(i);
+         else if (!omit_empty_cur && n_cur != 0) ret_occ.push(i, 0, 0);)
 
       R_len_t     str_cur_n = str_cont.get(i).length();
-      const char* str_cur_s = str_cont.get(i).c_str();
 
       if (n_cur >= INT_MAX-1)
          throw StriException(MSG__EXPECTED_SMALLER, "n");
       else if (n_cur < 0)
          n_cur = INT_MAX;
-      else if (n_cur == 0) {
-         SET_VECTOR_ELT(ret, i, Rf_allocVector(STRSXP, 0));
-         continue;
-      }
+      else if (n_cur == 0)
+         continue; // no fields
       else if (tokens_only1)
          n_cur++; // we need to do one split ahead here
 
@@ -168,25 +170,20 @@ SEXP stri_split_fixed(SEXP str, SEXP pattern, SEXP n,
             fields.pop_back(); // get rid of the remainder
       }
 
-      SEXP ans;
-      STRI__PROTECT(ans = Rf_allocVector(STRSXP, fields.size()));
-
       deque< pair<R_len_t, R_len_t> >::iterator iter = fields.begin();
-      for (k = 0; iter != fields.end(); ++iter, ++k) {
+      for (; iter != fields.end(); ++iter) {
          pair<R_len_t, R_len_t> curoccur = *iter;
          if (curoccur.second == curoccur.first && omit_empty_cont.isNA(i))
-            SET_STRING_ELT(ans, k, NA_STRING);
+            ret_occ.pushNA(i);
          else
-            SET_STRING_ELT(ans, k,
-               Rf_mkCharLenCE(str_cur_s+curoccur.first,
-                  curoccur.second-curoccur.first, CE_UTF8));
+            ret_occ.push(i, curoccur.first, curoccur.second);
       }
-
-      SET_VECTOR_ELT(ret, i, ans);
-      STRI__UNPROTECT(1);
    }
 
-   if (LOGICAL(simplify)[0] == NA_LOGICAL || LOGICAL(simplify)[0]) {
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toCharacter(str, str_cont, flatten1));
+
+   if (!flatten1 && (LOGICAL(simplify)[0] == NA_LOGICAL || LOGICAL(simplify)[0])) {
       R_len_t n_min = 0;
       R_len_t n_length = LENGTH(n);
       int* n_tab = INTEGER(n);
@@ -37,13 +37,59 @@
 #include "stri_container_bytesearch.h"
 #include "stri_container_integer.h"
 #include "stri_container_logical.h"
-#include <deque>
-#include <utility>
+#include "stri_newline.h"
+#include "stri_substrings.h"
 #include <unicode/brkiter.h>
 #include <unicode/rbbi.h>
 using namespace std;
 
 
+/**
+ * Split a UTF-8 string into text lines
+ *
+ * The input is scanned twice: first the lines are counted,
+ * then they are copied to a vector allocated at once
+ * (or just referred to, see StriSubstrings).
+ *
+ * @param str character vector
+ * @param str_cont \code{str}'s contents
+ * @param i index of the (non-NA) string to split
+ * @param omit_empty whether empty lines should be omitted
+ * @param omit_last_empty whether an empty line after the last newline
+ *    marker should be omitted
+ *
+ * @return character vector
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static SEXP stri__split_lines(SEXP str, const StriContainerUTF8& str_cont, R_len_t i,
+   bool omit_empty, bool omit_last_empty)
+{
+   const char* s = str_cont.get(i).c_str();
+   R_len_t n = str_cont.get(i).length();
+   size_t start, end, next;
+   R_len_t nlines = 0;
+   for (start = 0; (end = stri__find_newline(s, start, (size_t)n, next)) < (size_t)n; start = next)
+      if (!omit_empty || end > start) ++nlines;
+   // the text after the last newline marker (start > 0 iff there was a marker)
+   if (start < (size_t)n || (!omit_empty && (!omit_last_empty || start == 0)))
+      ++nlines;
+
+   SEXP ans;
+   PROTECT(ans = StriSubstrings::alloc(str, str_cont, nlines, i));
+   StriSubstrings ans_sub(ans, str, str_cont);
+   R_len_t k = 0;
+   for (start = 0; k < nlines; start = next) {
+      end = stri__find_newline(s, start, (size_t)n, next);
+      if (!omit_empty || end > start)
+         ans_sub.set(k++, i, (R_len_t)start, (R_len_t)(end-start));
+   }
+   PROTECT(ans = ans_sub.toR());
+   UNPROTECT(2);
+   return ans;
+}
+
+
 /**
  * Split a single string into text lines
  *
@@ -55,6 +101,9 @@ using namespace std;
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-05)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use stri__split_lines (block-wise newline search)
  */
 SEXP stri_split_lines1(SEXP str)
 {
@@ -69,62 +118,8 @@ SEXP stri_split_lines1(SEXP str)
       return str;
    }
 
-   const char* str_cur_s = str_cont.get(0).c_str();
-   R_len_t str_cur_n = str_cont.get(0).length();
-
-   UChar32 c;
-   R_len_t jlast;
-   deque< pair<R_len_t, R_len_t> > occurrences;
-   occurrences.push_back(pair<R_len_t, R_len_t>(0, 0));
-   for (R_len_t j=0; j < str_cur_n; /* null */) {
-      jlast = j;
-      U8_NEXT(str_cur_s, j, str_cur_n, c);
-
-      switch (c) {
-         case ASCII_CR: /* CR */
-            /* check if next is LF */
-            if (str_cur_s[j] == ASCII_LF) { // look ahead one byte
-               j++; // just one byte
-            }
-            break;
-
-         case ASCII_LF: /* LF */
-            break;
-
-         case UCHAR_NEL: /* NEL */
-            break;
-
-         case ASCII_VT: /* VT */
-            break;
-
-         case ASCII_FF: /* FF */
-            break;
-
-         case UCHAR_LS: /* LS */
-            break;
-
-         case UCHAR_PS: /* PS */
-            break;
-
-         default:
-            /* not a newline character */
-            occurrences.back().second = j;
-            continue;
-      }
-
-      occurrences.back().second = jlast;
-      if (j < str_cur_n)
-         occurrences.push_back(pair<R_len_t, R_len_t>(j, j));
-   }
-
    SEXP ans;
-   STRI__PROTECT(ans = Rf_allocVector(STRSXP, (R_len_t)occurrences.size()));
-   deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-   for (R_len_t k = 0; iter != occurrences.end(); ++iter, ++k) {
-      pair<R_len_t, R_len_t> curoccur = *iter;
-      SET_STRING_ELT(ans, k,
-         Rf_mkCharLenCE(str_cur_s+curoccur.first, curoccur.second-curoccur.first, CE_UTF8));
-   }
+   STRI__PROTECT(ans = stri__split_lines(str, str_cont, 0, false, true));
    STRI__UNPROTECT_ALL
    return ans;
 
@@ -147,6 +142,9 @@ SEXP stri_split_lines1(SEXP str)
  *
  * @version 0.3-1 (Marek Gagolewski, 2014-11-05)
  *    Issue #112: str_prepare_arg* retvals were not PROTECTed from gc
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use stri__split_lines (block-wise newline search)
  */
 SEXP stri_split_lines(SEXP str, SEXP omit_empty)
 {
@@ -172,106 +170,10 @@ SEXP stri_split_lines(SEXP str, SEXP omit_empty)
          continue;
       }
 
-      const char* str_cur_s = str_cont.get(i).c_str();
-      R_len_t str_cur_n = str_cont.get(i).length();
-//      int  n_max_cur        = n_max_cont.get(i);
       int  omit_empty_cur   = omit_empty_cont.get(i);
 
-//      if (n_max_cur < 0)
-//         n_max_cur = INT_MAX;
-//      else if (n_max_cur == 0) {
-//         SET_VECTOR_ELT(ret, i, Rf_allocVector(STRSXP, 0));
-//         continue;
-//      }
-
-//#define STRI_INDEX_NEWLINE_CR   0
-//#define STRI_INDEX_NEWLINE_LF   1
-//#define STRI_INDEX_NEWLINE_CRLF 2
-//#define STRI_INDEX_NEWLINE_NEL  3
-//#define STRI_INDEX_NEWLINE_VT   4
-//#define STRI_INDEX_NEWLINE_FF   5
-//#define STRI_INDEX_NEWLINE_LS   6
-//#define STRI_INDEX_NEWLINE_PS   7
-//#define STRI_INDEX_NEWLINE_LAST 8
-
-//      int counts[STRI_INDEX_NEWLINE_LAST];
-//      for (R_len_t j=0; j<STRI_INDEX_NEWLINE_LAST; ++j)
-//         counts[j] = 0;
-
-      UChar32 c;
-      R_len_t jlast, k=1;
-      deque< pair<R_len_t, R_len_t> > occurrences;
-      occurrences.push_back(pair<R_len_t, R_len_t>(0, 0));
-      for (R_len_t j=0; j < str_cur_n /*&& k < n_max_cur*/; /* null */) {
-         jlast = j;
-         U8_NEXT(str_cur_s, j, str_cur_n, c);
-
-         switch (c) {
-            case ASCII_CR: /* CR */
-//               counts[STRI_INDEX_NEWLINE_CR]++;
-               /* check if next is LF */
-               if (str_cur_s[j] == ASCII_LF) { // look ahead one byte
-//                  counts[STRI_INDEX_NEWLINE_LF]++;
-//                  counts[STRI_INDEX_NEWLINE_CRLF]++;
-                  j++; // just one byte
-               }
-               break;
-
-            case ASCII_LF: /* LF */
-//               counts[STRI_INDEX_NEWLINE_LF]++;
-               break;
-
-            case UCHAR_NEL: /* NEL */
-//               counts[STRI_INDEX_NEWLINE_NEL]++;
-               break;
-
-            case ASCII_VT: /* VT */
-//               counts[STRI_INDEX_NEWLINE_VT]++;
-               break;
-
-            case ASCII_FF: /* FF */
-//               counts[STRI_INDEX_NEWLINE_FF]++;
-               break;
-
-            case UCHAR_LS: /* LS */
-//               counts[STRI_INDEX_NEWLINE_LS]++;
-               break;
-
-            case UCHAR_PS: /* PS */
-//               counts[STRI_INDEX_NEWLINE_PS]++;
-               break;
-
-            default:
-               /* not a newline character */
-               occurrences.back().second = j;
-               continue;
-         }
-
-         // if here, then at newline
-         if (omit_empty_cur && occurrences.back().second == occurrences.back().first)
-            occurrences.back().first = occurrences.back().second = j; // don't start any new field
-         else {
-            occurrences.back().second = jlast;
-            occurrences.push_back(pair<R_len_t, R_len_t>(j, j));
-            ++k; // another field
-         }
-      }
-
-//      if (k == n_max_cur)
-//         occurrences.back().second = str_cur_n;
-      if (omit_empty_cur && occurrences.back().first == occurrences.back().second)
-         occurrences.pop_back();
-
       SEXP ans;
-      STRI__PROTECT(ans = Rf_allocVector(STRSXP, (R_len_t)occurrences.size()));
-
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t l = 0; iter != occurrences.end(); ++iter, ++l) {
-         pair<R_len_t, R_len_t> curoccur = *iter;
-         SET_STRING_ELT(ans, l,
-            Rf_mkCharLenCE(str_cur_s+curoccur.first, curoccur.second-curoccur.first, CE_UTF8));
-      }
-
+      STRI__PROTECT(ans = stri__split_lines(str, str_cont, i, omit_empty_cur, false));
       SET_VECTOR_ELT(ret, i, ans);
       STRI__UNPROTECT(1);
    }
@@ -33,6 +33,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf16.h"
 #include "stri_container_regex.h"
+#include "stri_occurrences.h"
 #include <deque>
 #include <utility>
 using namespace std;
@@ -61,12 +62,16 @@ using namespace std;
  *
  * @version 1.0-2 (Marek Gagolewski, 2016-01-29)
  *    Issue #214: allow a regex pattern like `.*`  to match an empty string
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts_regex)
+SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP flatten, SEXP opts_regex)
 {
    // ??? @TODO: capture_group arg (integer vector which capture group to locate) ???
    // ??? OR introduce stri_matchpos_*_regex ???
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    uint32_t pattern_flags = StriContainerRegexPattern::getRegexFlags(opts_regex);
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern")); // prepare string argument
@@ -75,58 +80,44 @@ SEXP stri_locate_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP opts
    STRI__ERROR_HANDLER_BEGIN(2)
    StriContainerUTF16 str_cont(str, vectorize_length);
    StriContainerRegexPattern pattern_cont(pattern, vectorize_length, pattern_flags);
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
          i = pattern_cont.vectorize_next(i))
    {
       STRI__CONTINUE_ON_EMPTY_OR_NA_PATTERN(str_cont, pattern_cont,
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(1, 2));)
+         ret_occ.pushNA(i);)
 
       RegexMatcher *matcher = pattern_cont.getMatcher(i); // will be deleted automatically
       matcher->reset(str_cont.get(i));
       int found = (int)matcher->find();
       if (!found) {
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_INTEGER(omit_no_match1?0:1, 2));
+         ret_occ.pushNA(i, omit_no_match1?0:1);
          continue;
       }
 
-      deque< pair<R_len_t, R_len_t> > occurrences;
+      R_len_t k = ret_occ.size();
       do {
          UErrorCode status = U_ZERO_ERROR;
          int start = (int)matcher->start(status);
          int end  =  (int)matcher->end(status);
          STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
-         occurrences.push_back(pair<R_len_t, R_len_t>(start, end));
+         ret_occ.push(i, start, end);
          found = (int)matcher->find();
       } while (found);
 
-      R_len_t noccurrences = (R_len_t)occurrences.size();
-      SEXP ans;
-      STRI__PROTECT(ans = Rf_allocMatrix(INTSXP, noccurrences, 2));
-      int* ans_tab = INTEGER(ans);
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t j = 0; iter != occurrences.end(); ++iter, ++j) {
-         pair<R_len_t, R_len_t> match = *iter;
-         ans_tab[j]             = match.first;
-         ans_tab[j+noccurrences] = match.second;
-      }
-
       // Adjust UChar index -> UChar32 index (1-2 byte UTF16 to 1 byte UTF32-code points)
-      str_cont.UChar16_to_UChar32_index(i, ans_tab,
-            ans_tab+noccurrences, noccurrences,
+      str_cont.UChar16_to_UChar32_index(i, ret_occ.getStarts(k),
+            ret_occ.getEnds(k), ret_occ.size()-k,
             1, // 0-based index -> 1-based
             0  // end returns position of next character after match
       );
-      SET_VECTOR_ELT(ret, i, ans);
-      STRI__UNPROTECT(1);
    }
 
-   stri__locate_set_dimnames_list(ret);
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toInteger(flatten1));
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
@@ -33,6 +33,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_container_regex.h"
+#include "stri_occurrences.h"
 #include <vector>
 #include <deque>
 #include <utility>
@@ -238,10 +239,14 @@ SEXP stri_match_last_regex(SEXP str, SEXP pattern, SEXP cg_missing, SEXP opts_re
  *
  * @version 1.0-2 (Marek Gagolewski, 2016-01-29)
  *    Issue #214: allow a regex pattern like `.*`  to match an empty string
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    new arg: flatten; use StriOccurrences
  */
-SEXP stri_match_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP cg_missing, SEXP opts_regex)
+SEXP stri_match_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP cg_missing, SEXP flatten, SEXP opts_regex)
 {
    bool omit_no_match1 = stri__prepare_arg_logical_1_notNA(omit_no_match, "omit_no_match");
+   bool flatten1 = stri__prepare_arg_logical_1_notNA(flatten, "flatten");
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
    PROTECT(pattern = stri_prepare_arg_string(pattern, "pattern")); // prepare string argument
    PROTECT(cg_missing = stri_prepare_arg_string_1(cg_missing, "cg_missing"));
@@ -255,9 +260,7 @@ SEXP stri_match_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP cg_mi
    StriContainerRegexPattern pattern_cont(pattern, vectorize_length, pattern_flags);
    StriContainerUTF8 cg_missing_cont(cg_missing, 1);
    STRI__PROTECT(cg_missing = STRING_ELT(cg_missing, 0));
-
-   SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(VECSXP, vectorize_length));
+   StriOccurrences ret_occ(vectorize_length);
 
    for (R_len_t i = pattern_cont.vectorize_init();
          i != pattern_cont.vectorize_end();
@@ -266,16 +269,17 @@ SEXP stri_match_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP cg_mi
       if ((pattern_cont).isNA(i) || (pattern_cont).get(i).length() <= 0) {
          if (!(pattern_cont).isNA(i))
             Rf_warning(MSG__EMPTY_SEARCH_PATTERN_UNSUPPORTED);
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_STRING(1, 1));
+         ret_occ.pushNA(i);
          continue;
       }
 
       UErrorCode status = U_ZERO_ERROR;
       RegexMatcher *matcher = pattern_cont.getMatcher(i); // will be deleted automatically
       int pattern_cur_groups = matcher->groupCount();
+      ret_occ.setNumCols(i, pattern_cur_groups+1);
 
       if ((str_cont).isNA(i)) {
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_STRING(1, pattern_cur_groups+1));
+         ret_occ.pushNA(i);
          continue;
       }
 
@@ -284,45 +288,27 @@ SEXP stri_match_all_regex(SEXP str, SEXP pattern, SEXP omit_no_match, SEXP cg_mi
 
       matcher->reset(str_text);
 
-      deque< pair<R_len_t, R_len_t> > occurrences;
+      R_len_t k = ret_occ.size();
       while ((int)matcher->find()) {
-         occurrences.push_back(pair<R_len_t, R_len_t>((R_len_t)matcher->start(status), (R_len_t)matcher->end(status)));
+         // a capture group that did not participate in the match
+         // has start=end=-1, this will give cg_missing
+         ret_occ.push(i, (R_len_t)matcher->start(status), (R_len_t)matcher->end(status));
          for (R_len_t j=0; j<pattern_cur_groups; ++j)
-            occurrences.push_back(pair<R_len_t, R_len_t>((R_len_t)matcher->start(j+1, status), (R_len_t)matcher->end(j+1, status)));
+            ret_occ.push(i, (R_len_t)matcher->start(j+1, status), (R_len_t)matcher->end(j+1, status));
          STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
       }
 
-      R_len_t noccurrences = (R_len_t)occurrences.size()/(pattern_cur_groups+1);
-      if (noccurrences <= 0) {
-         SET_VECTOR_ELT(ret, i, stri__matrix_NA_STRING(omit_no_match1?0:1, pattern_cur_groups+1));
-         continue;
-      }
-
-      const char* str_cur_s = str_cont.get(i).c_str();
-      SEXP cur_res;
-      STRI__PROTECT(cur_res = Rf_allocMatrix(STRSXP, noccurrences, pattern_cur_groups+1));
-      deque< pair<R_len_t, R_len_t> >::iterator iter = occurrences.begin();
-      for (R_len_t j = 0; iter != occurrences.end(); ++j) {
-         pair<R_len_t, R_len_t> curo = *iter;
-         SET_STRING_ELT(cur_res, j, Rf_mkCharLenCE(str_cur_s+curo.first, curo.second-curo.first, CE_UTF8));
-         ++iter;
-         for (R_len_t k = 0; iter != occurrences.end() && k < pattern_cur_groups; ++iter, ++k) {
-            curo = *iter;
-            if (curo.first < 0 || curo.second < 0)
-               SET_STRING_ELT(cur_res, j+(k+1)*noccurrences, cg_missing);
-            else
-               SET_STRING_ELT(cur_res, j+(k+1)*noccurrences,
-                  Rf_mkCharLenCE(str_cur_s+curo.first, curo.second-curo.first, CE_UTF8));
-         }
-      }
-      SET_VECTOR_ELT(ret, i, cur_res);
-      STRI__UNPROTECT(1);
+      if (ret_occ.size() == k) // no match
+         ret_occ.pushNA(i, omit_no_match1?0:1);
    }
 
    if (str_text) {
       utext_close(str_text);
       str_text = NULL;
    }
+
+   SEXP ret;
+   STRI__PROTECT(ret = ret_occ.toCharacter(str, str_cont, flatten1, true, cg_missing));
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END(if (str_text) utext_close(str_text);)
@@ -63,6 +63,10 @@
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-02-14)
  *          new field: m_isASCII
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *          new field: m_memarena; initialize() may draw memory
+ *          from a String8Arena
  */
 class String8  {
 
@@ -71,6 +75,7 @@ class String8  {
       char* m_str;      ///< character data in UTF-8, NULL denotes NA
       R_len_t m_n;      ///< string length (in bytes), not including NUL
       bool m_memalloc;  ///< should the memory be freed at the end
+      bool m_memarena;  ///< is the memory owned by a String8Arena?
       bool m_isASCII;   ///< ASCII or UTF-8?
 
 
@@ -83,10 +88,20 @@ class String8  {
          this->m_str = NULL; // a missing value
          this->m_n = 0;
          this->m_memalloc = false;
+         this->m_memarena = false;
          this->m_isASCII = false;
       }
 
 
+      /** get a buffer of n+1 bytes, from the arena if given */
+      static inline char* allocBuffer(R_len_t n, String8Arena* arena)
+      {
+         char* buf = (arena)?arena->allocate((size_t)n+1):new char[n+1];
+         if (!buf) throw StriException(MSG__MEM_ALLOC_ERROR);
+         return buf;
+      }
+
+
       /** used to set data (construct already created,
        * but NA-initialized object)
        *
@@ -95,8 +110,11 @@ class String8  {
        * @param memalloc should a deep copy of the buffer be done?
        * @param killbom whether to detect and delete UTF-8 BOMs
        * @param isASCII
+       * @param arena if not NULL, deep copies are stored in this arena
+       *    (which must outlive this object)
        */
-      void initialize(const char* str, R_len_t n, bool memalloc, bool killbom, bool isASCII)
+      void initialize(const char* str, R_len_t n, bool memalloc, bool killbom, bool isASCII,
+         String8Arena* arena=NULL)
       {
 #ifndef NDEBUG
          if (!isNA())
@@ -107,21 +125,21 @@ class String8  {
             (uint8_t)(str[1]) == UTF8_BOM_BYTE2 &&
             (uint8_t)(str[2]) == UTF8_BOM_BYTE3) {
             // has BOM - get rid of it
-            this->m_memalloc = true; // ignore memalloc val
+            this->m_memalloc = !arena; // ignore memalloc val
+            this->m_memarena = !!arena;
             this->m_n = n-3;
             this->m_isASCII = isASCII;
-            this->m_str = new char[this->m_n+1];
-            if (!this->m_str) throw StriException(MSG__MEM_ALLOC_ERROR);
+            this->m_str = allocBuffer(this->m_n, arena);
             memcpy(this->m_str, str+3, (size_t)this->m_n);
             this->m_str[this->m_n] = '\0';
          }
          else {
-            this->m_memalloc = memalloc;
+            this->m_memalloc = memalloc && !arena;
+            this->m_memarena = memalloc && !!arena;
             this->m_n = n;
             this->m_isASCII = isASCII;
             if (memalloc) {
-               this->m_str = new char[this->m_n+1];
-               if (!this->m_str) throw StriException(MSG__MEM_ALLOC_ERROR);
+               this->m_str = allocBuffer(this->m_n, arena);
                // memcpy may be very fast in some libc implementations
                memcpy(this->m_str, str, (size_t)this->m_n);
                this->m_str[this->m_n] = '\0';
@@ -140,11 +158,13 @@ class String8  {
        * @param memalloc should a deep copy of the buffer be done?
        * @param killbom whether to detect and delete UTF-8 BOMs
        * @param isASCII
+       * @param arena if not NULL, deep copies are stored in this arena
        */
-      String8(const char* str, R_len_t n, bool memalloc, bool killbom, bool isASCII)
+      String8(const char* str, R_len_t n, bool memalloc, bool killbom, bool isASCII,
+         String8Arena* arena=NULL)
       {
          this->m_str = NULL; // a missing value
-         initialize(str, n, memalloc, killbom, isASCII);
+         initialize(str, n, memalloc, killbom, isASCII, arena);
       }
 
 
@@ -166,17 +186,24 @@ class String8  {
                delete [] this->m_str;
             }
             this->m_str = NULL;
+            this->m_memalloc = false;
+            this->m_memarena = false;
          }
       }
 
 
-      /** copy constructor */
+      /** copy constructor
+       *
+       * arena-backed strings are copied onto the heap,
+       * as the copy may outlive the arena
+       */
       String8(const String8& s)
       {
-         this->m_memalloc = s.m_memalloc;
+         this->m_memalloc = s.m_memalloc || s.m_memarena;
+         this->m_memarena = false;
          this->m_n = s.m_n;
          this->m_isASCII = s.m_isASCII;
-         if (s.m_memalloc) {
+         if (this->m_memalloc) {
             this->m_str = new char[this->m_n+1];
             if (!this->m_str) throw StriException(MSG__MEM_ALLOC_ERROR);
             memcpy(this->m_str, s.m_str, (size_t)this->m_n);
@@ -193,10 +220,11 @@ class String8  {
          if (this->m_str && this->m_memalloc)
             delete [] this->m_str;
 
-         this->m_memalloc = s.m_memalloc;
+         this->m_memalloc = s.m_memalloc || s.m_memarena;
+         this->m_memarena = false;
          this->m_n = s.m_n;
          this->m_isASCII = s.m_isASCII;
-         if (s.m_memalloc) {
+         if (this->m_memalloc) {
             this->m_str = new char[this->m_n+1];
             if (!this->m_str) throw StriException(MSG__MEM_ALLOC_ERROR);
             memcpy(this->m_str, s.m_str, (size_t)this->m_n);
@@ -228,7 +256,7 @@ class String8  {
        *  or is this string a shallow copy of some "external" resource?
        */
       inline bool isReadOnly() const {
-         return !this->m_memalloc;
+         return !this->m_memalloc && !this->m_memarena;
       }
 
       /** return the char buffer */
@@ -350,10 +378,18 @@ class String8  {
        *
        *
        * @version 0.3-1 (Marek Gagolewski, 2014-11-02)
+       *
+       * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+       *    the old buffer may have been drawn from an arena;
+       *    new param: arena
+       *
+       * @param arena if not NULL, the new buffer is drawn from this arena
+       *    (which must outlive this object), otherwise from the heap
        */
       void replaceAllAtPos(R_len_t buf_size,
          const char* replacement_cur_s, R_len_t replacement_cur_n,
-         std::deque< std::pair<R_len_t, R_len_t> >& occurrences)
+         std::deque< std::pair<R_len_t, R_len_t> >& occurrences,
+         String8Arena* arena=NULL)
       {
 #ifndef NDEBUG
          if (isNA()) throw StriException("String8::isNA() in replaceAllAtPos()");
@@ -361,9 +397,10 @@ class String8  {
          char* old_str = this->m_str;
          int old_n = this->m_n;
          bool old_memalloc = this->m_memalloc;
-         this->m_str = new char[buf_size+1];
+         this->m_str = allocBuffer(buf_size, arena);
          this->m_n = buf_size;
-         this->m_memalloc = true;
+         this->m_memalloc = !arena;
+         this->m_memarena = !!arena;
          this->m_isASCII = true; /* TO DO */
 
          R_len_t buf_used = 0;
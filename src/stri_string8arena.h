@@ -0,0 +1,124 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_string8arena_h
+#define __stri_string8arena_h
+
+
+/** default size of a memory block in String8Arena, in bytes */
+#define STRI__STRING8ARENA_BLOCKSIZE 65536
+
+
+/**
+ * A simple bump allocator for String8 data
+ *
+ * Memory is acquired in large blocks and it is released all at once,
+ * when the arena is destroyed or reset. This way we avoid calling
+ * new/delete for each string, e.g., when re-encoding whole
+ * character vectors or replacing substrings in writable containers.
+ *
+ * Each arena is owned by a string container. String8s
+ * which use it (see String8::initialize) never free the memory themselves.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class String8Arena  {
+
+   private:
+
+      std::vector<char*> m_blocks; ///< all the blocks allocated
+      char* m_cur;                 ///< first free byte in the current block
+      size_t m_left;               ///< number of free bytes in the current block
+
+      String8Arena(const String8Arena&);            // no copies
+      String8Arena& operator=(const String8Arena&); // no copies
+
+
+   public:
+
+      String8Arena() {
+         this->m_cur = NULL;
+         this->m_left = 0;
+      }
+
+
+      ~String8Arena() {
+         reset();
+      }
+
+
+      /** release all the memory; the buffers allocated so far
+       * are no longer valid
+       */
+      void reset() {
+         for (size_t i=0; i<m_blocks.size(); ++i)
+            free(m_blocks[i]);
+         m_blocks.clear();
+         this->m_cur = NULL;
+         this->m_left = 0;
+      }
+
+
+      /** get a buffer that will live as long as this arena
+       *
+       * @param size number of bytes
+       * @return pointer to a new buffer
+       */
+      char* allocate(size_t size) {
+         if (size <= m_left) {
+            char* ret = m_cur;
+            m_cur  += size;
+            m_left -= size;
+            return ret;
+         }
+
+         if (size > STRI__STRING8ARENA_BLOCKSIZE/4) {
+            // a large string gets its own block (and the current one is kept)
+            char* ret = (char*)malloc(size);
+            if (!ret) throw StriException(MSG__MEM_ALLOC_ERROR);
+            m_blocks.push_back(ret);
+            return ret;
+         }
+
+         m_cur = (char*)malloc(STRI__STRING8ARENA_BLOCKSIZE);
+         if (!m_cur) throw StriException(MSG__MEM_ALLOC_ERROR);
+         m_blocks.push_back(m_cur);
+         m_left = STRI__STRING8ARENA_BLOCKSIZE;
+
+         char* ret = m_cur;
+         m_cur  += size;
+         m_left -= size;
+         return ret;
+      }
+};
+
+#endif
@@ -34,6 +34,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <unicode/uclean.h>
+#include "stri_brkiter.h"
 
 #ifndef STRI_ICU_FOUND
 #include "uconfig_local.h"
@@ -111,16 +112,16 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_extract_all_boundaries",       stri_extract_all_boundaries,     4),
    STRI__MK_CALL("C_stri_extract_first_charclass",      stri_extract_first_charclass,    2),
    STRI__MK_CALL("C_stri_extract_last_charclass",       stri_extract_last_charclass,     2),
-   STRI__MK_CALL("C_stri_extract_all_charclass",        stri_extract_all_charclass,      5),
+   STRI__MK_CALL("C_stri_extract_all_charclass",        stri_extract_all_charclass,      6),
    STRI__MK_CALL("C_stri_extract_first_coll",           stri_extract_first_coll,         3),
    STRI__MK_CALL("C_stri_extract_last_coll",            stri_extract_last_coll,          3),
    STRI__MK_CALL("C_stri_extract_all_coll",             stri_extract_all_coll,           5),
    STRI__MK_CALL("C_stri_extract_first_fixed",          stri_extract_first_fixed,        3),
    STRI__MK_CALL("C_stri_extract_last_fixed",           stri_extract_last_fixed,         3),
-   STRI__MK_CALL("C_stri_extract_all_fixed",            stri_extract_all_fixed,          5),
+   STRI__MK_CALL("C_stri_extract_all_fixed",            stri_extract_all_fixed,          6),
    STRI__MK_CALL("C_stri_extract_first_regex",          stri_extract_first_regex,        3),
    STRI__MK_CALL("C_stri_extract_last_regex",           stri_extract_last_regex,         3),
-   STRI__MK_CALL("C_stri_extract_all_regex",            stri_extract_all_regex,          5),
+   STRI__MK_CALL("C_stri_extract_all_regex",            stri_extract_all_regex,          6),
    STRI__MK_CALL("C_stri_flatten",                      stri_flatten,                    4),
 //   STRI__MK_CALL("C_stri_in_fixed",                   stri_in_fixed,                   3),  // TODO: version >= 0.6
    STRI__MK_CALL("C_stri_info",                         stri_info,                       0),
@@ -139,19 +140,19 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_locate_last_boundaries",       stri_locate_last_boundaries,     2),
    STRI__MK_CALL("C_stri_locate_first_charclass",       stri_locate_first_charclass,     2),
    STRI__MK_CALL("C_stri_locate_last_charclass",        stri_locate_last_charclass,      2),
-   STRI__MK_CALL("C_stri_locate_all_charclass",         stri_locate_all_charclass,       4),
+   STRI__MK_CALL("C_stri_locate_all_charclass",         stri_locate_all_charclass,       5),
    STRI__MK_CALL("C_stri_locate_last_fixed",            stri_locate_last_fixed,          3),
    STRI__MK_CALL("C_stri_locate_first_fixed",           stri_locate_first_fixed,         3),
-   STRI__MK_CALL("C_stri_locate_all_fixed",             stri_locate_all_fixed,           4),
+   STRI__MK_CALL("C_stri_locate_all_fixed",             stri_locate_all_fixed,           5),
    STRI__MK_CALL("C_stri_locate_last_coll",             stri_locate_last_coll,           3),
    STRI__MK_CALL("C_stri_locate_first_coll",            stri_locate_first_coll,          3),
    STRI__MK_CALL("C_stri_locate_all_coll",              stri_locate_all_coll,            4),
-   STRI__MK_CALL("C_stri_locate_all_regex",             stri_locate_all_regex,           4),
+   STRI__MK_CALL("C_stri_locate_all_regex",             stri_locate_all_regex,           5),
    STRI__MK_CALL("C_stri_locate_first_regex",           stri_locate_first_regex,         3),
    STRI__MK_CALL("C_stri_locate_last_regex",            stri_locate_last_regex,          3),
    STRI__MK_CALL("C_stri_match_first_regex",            stri_match_first_regex,          4),
    STRI__MK_CALL("C_stri_match_last_regex",             stri_match_last_regex,           4),
-   STRI__MK_CALL("C_stri_match_all_regex",              stri_match_all_regex,            5),
+   STRI__MK_CALL("C_stri_match_all_regex",              stri_match_all_regex,            6),
    STRI__MK_CALL("C_stri_numbytes",                     stri_numbytes,                   1),
    STRI__MK_CALL("C_stri_order",                        stri_order,                      4),
    STRI__MK_CALL("C_stri_sort",                         stri_sort,                       4),
@@ -168,6 +169,10 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_prepare_arg_logical_1",        stri_prepare_arg_logical_1,      2),
    STRI__MK_CALL("C_stri_rand_shuffle",                 stri_rand_shuffle,               1),
    STRI__MK_CALL("C_stri_rand_strings",                 stri_rand_strings,               3),
+   STRI__MK_CALL("C_stri_read_lines",                   stri_read_lines,                 2),
+   STRI__MK_CALL("C_stri_read_lines_close",             stri_read_lines_close,           1),
+   STRI__MK_CALL("C_stri_read_lines_next",              stri_read_lines_next,            2),
+   STRI__MK_CALL("C_stri_read_lines_open",              stri_read_lines_open,            2),
    STRI__MK_CALL("C_stri_replace_na",                   stri_replace_na,                 2),
    STRI__MK_CALL("C_stri_replace_all_fixed",            stri_replace_all_fixed,          5),
    STRI__MK_CALL("C_stri_replace_first_fixed",          stri_replace_first_fixed,        4),
@@ -183,12 +188,12 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_replace_last_charclass",       stri_replace_last_charclass,     3),
    STRI__MK_CALL("C_stri_reverse",                      stri_reverse,                    1),
    STRI__MK_CALL("C_stri_split_boundaries",             stri_split_boundaries,           5),
-   STRI__MK_CALL("C_stri_split_charclass",              stri_split_charclass,            6),
+   STRI__MK_CALL("C_stri_split_charclass",              stri_split_charclass,            7),
    STRI__MK_CALL("C_stri_split_coll",                   stri_split_coll,                 7),
-   STRI__MK_CALL("C_stri_split_fixed",                  stri_split_fixed,                7),
+   STRI__MK_CALL("C_stri_split_fixed",                  stri_split_fixed,                8),
    STRI__MK_CALL("C_stri_split_lines",                  stri_split_lines,                2),
    STRI__MK_CALL("C_stri_split_lines1",                 stri_split_lines1,               1),
-   STRI__MK_CALL("C_stri_split_regex",                  stri_split_regex,                7),
+   STRI__MK_CALL("C_stri_split_regex",                  stri_split_regex,                8),
    STRI__MK_CALL("C_stri_startswith_charclass",         stri_startswith_charclass,       3),
    STRI__MK_CALL("C_stri_startswith_coll",              stri_startswith_coll,            4),
    STRI__MK_CALL("C_stri_startswith_fixed",             stri_startswith_fixed,           4),
@@ -204,6 +209,7 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_subset_coll_replacement",      stri_subset_coll_replacement,    5),
    STRI__MK_CALL("C_stri_subset_fixed_replacement",     stri_subset_fixed_replacement,   5),
    STRI__MK_CALL("C_stri_subset_regex_replacement",     stri_subset_regex_replacement,   5),
+   STRI__MK_CALL("C_stri_test_brkiter_ascii",           stri_test_brkiter_ascii,         1),
    STRI__MK_CALL("C_stri_test_Rmark",                   stri_test_Rmark,                 1),
    STRI__MK_CALL("C_stri_test_returnasis",              stri_test_returnasis,            1),
    STRI__MK_CALL("C_stri_test_UnicodeContainer16",      stri_test_UnicodeContainer16,    1),
@@ -218,13 +224,14 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_trans_isnfkc",                 stri_trans_isnfkc,               1),
    STRI__MK_CALL("C_stri_trans_isnfkd",                 stri_trans_isnfkd,               1),
    STRI__MK_CALL("C_stri_trans_isnfkc_casefold",        stri_trans_isnfkc_casefold,      1),
-   STRI__MK_CALL("C_stri_trans_general",                stri_trans_general,              2),
+   STRI__MK_CALL("C_stri_trans_general",                stri_trans_general,              3),
    STRI__MK_CALL("C_stri_trans_list",                   stri_trans_list,                 0),
    STRI__MK_CALL("C_stri_trans_nfc",                    stri_trans_nfc,                  1),
    STRI__MK_CALL("C_stri_trans_nfd",                    stri_trans_nfd,                  1),
    STRI__MK_CALL("C_stri_trans_nfkc",                   stri_trans_nfkc,                 1),
    STRI__MK_CALL("C_stri_trans_nfkd",                   stri_trans_nfkd,                 1),
    STRI__MK_CALL("C_stri_trans_nfkc_casefold",          stri_trans_nfkc_casefold,        1),
+   STRI__MK_CALL("C_stri_trans_pipeline",               stri_trans_pipeline,             2),
    STRI__MK_CALL("C_stri_trans_totitle",                stri_trans_totitle,              2),
    STRI__MK_CALL("C_stri_trans_tolower",                stri_trans_tolower,              2),
    STRI__MK_CALL("C_stri_trans_toupper",                stri_trans_toupper,              2),
@@ -235,6 +242,7 @@ const R_CallMethodDef cCallMethods[] = {
    STRI__MK_CALL("C_stri_unique",                       stri_unique,                     2),
    STRI__MK_CALL("C_stri_width",                        stri_width,                      1),
    STRI__MK_CALL("C_stri_wrap",                         stri_wrap,                      10),
+   STRI__MK_CALL("C_stri_write_lines",                  stri_write_lines,                4),
 //   STRI__MK_CALL("C_stri_trim_double",                stri_trim_double,                3), // TODO: version >= 0.6
 
    // the list must be NULL-terminated:
@@ -310,6 +318,8 @@ extern "C" void R_init_stringi(DllInfo* dll)
    R_forceSymbols(dll, (Rboolean)TRUE);
 #endif
 
+   stri__substrings_init(dll);
+
    const R_CallMethodDef* methods = cCallMethods;
    while (methods->name) {
       R_RegisterCCallable("stringi", methods->name, methods->fun);
@@ -350,6 +360,11 @@ extern "C" void  R_unload_stringi(DllInfo*)
 //   fprintf(stdout, "!NDEBUG: ************************************************\n");
 //   fprintf(stdout, "!NDEBUG: Dynamic library 'stringi' unloaded.\n");
 //   fprintf(stdout, "!NDEBUG: ************************************************\n");
+   StriBrkIterCache::clear(); // before u_cleanup()
+   stri__trans_general_clear_cache();
+   stri__datetime_format_clear_cache();
+   stri__width_clear_table();
+   stri__charclass_clear_cache();
    u_cleanup();
 }
 
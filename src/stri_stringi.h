@@ -37,6 +37,7 @@
 #include "stri_messages.h"
 #include "stri_macros.h"
 #include "stri_exception.h"
+#include "stri_string8arena.h"
 #include "stri_string8.h"
 #include "stri_container_utf8.h"
 #include "stri_container_utf16.h"
@@ -55,15 +56,35 @@ SEXP    stri__emptyList();
 SEXP    stri__matrix_NA_INTEGER(R_len_t nrow, R_len_t ncol);
 SEXP    stri__matrix_NA_STRING(R_len_t nrow, R_len_t ncol);
 int     stri__match_arg(const char* option, const char** set);
+SEXP    stri__unique_strings(SEXP str, bool trivial_ascii);
+SEXP    stri__unique_expand(SEXP ret_unique, SEXP index);
+
+// charclass.cpp
+void stri__charclass_clear_cache();
 
 // collator.cpp:
 struct UCollator;
 UCollator* stri__ucol_open(SEXP opts_collator);
 
+// encoding_detection.cpp
+double  stri__enc_check_ascii(const char* str_cur_s, R_len_t str_cur_n, bool get_confidence);
+double  stri__enc_check_utf8(const char* str_cur_s, R_len_t str_cur_n, bool get_confidence);
+
 // length.cpp
 R_len_t stri__numbytes_max(SEXP str);
 int     stri__width_char(UChar32 c);
 int     stri__width_string(const char* str_cur_s, int str_cur_n);
+void    stri__width_clear_table();
+
+// substrings.cpp
+void stri__substrings_init(DllInfo* dll);
+SEXP stri__substrings_length(SEXP x);
+
+// trans_transliterate.cpp
+void stri__trans_general_clear_cache();
+
+// time_format.cpp
+void stri__datetime_format_clear_cache();
 
 // prepare_arg.cpp:
 const char* stri__copy_string_Ralloc(SEXP, const char* argname);
@@ -98,6 +119,7 @@ SEXP stri_test_UnicodeContainer16(SEXP str);
 SEXP stri_test_UnicodeContainer16b(SEXP str);
 SEXP stri_test_UnicodeContainer8(SEXP str);
 SEXP stri_test_returnasis(SEXP x);
+SEXP stri_test_brkiter_ascii(SEXP opts_brkiter);
 
 // search
 void stri__locate_set_dimnames_list(SEXP list);
@@ -33,6 +33,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8_indexable.h"
 #include "stri_string8buf.h"
+#include "stri_substrings.h"
 
 /***
  * used both in stri_sub and stri_sub_replacement
@@ -146,6 +147,9 @@ inline void stri__sub_get_indices(StriContainerUTF8_indexable& str_cont, R_len_t
  *
  * @version 0.5-9003 (Marek Gagolewski, 2015-08-05)
  *    Bugfix #183: floating point exception when to or length is an empty vector
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriSubstrings (lazy results)
  */
 SEXP stri_sub(SEXP str, SEXP from, SEXP to, SEXP length)
 {
@@ -173,7 +177,8 @@ SEXP stri_sub(SEXP str, SEXP from, SEXP to, SEXP length)
    STRI__ERROR_HANDLER_BEGIN(4)
    StriContainerUTF8_indexable str_cont(str, vectorize_len);
    SEXP ret;
-   STRI__PROTECT(ret = Rf_allocVector(STRSXP, vectorize_len));
+   STRI__PROTECT(ret = StriSubstrings::alloc(str, str_cont, vectorize_len));
+   StriSubstrings ret_sub(ret, str, str_cont);
 
    for (R_len_t i = str_cont.vectorize_init();
          i != str_cont.vectorize_end();
@@ -182,35 +187,34 @@ SEXP stri_sub(SEXP str, SEXP from, SEXP to, SEXP length)
       R_len_t cur_from     = from_tab[i % from_len];
       R_len_t cur_to       = (to_tab)?to_tab[i % to_len]:length_tab[i % length_len];
       if (str_cont.isNA(i) || cur_from == NA_INTEGER || cur_to == NA_INTEGER) {
-         SET_STRING_ELT(ret, i, NA_STRING);
+         ret_sub.setNA(i);
          continue;
       }
 
       if (length_tab) {
          if (cur_to <= 0) {
-            SET_STRING_ELT(ret, i, R_BlankString);
+            ret_sub.set(i, i, 0, 0);
             continue;
          }
          cur_to = cur_from + cur_to - 1;
          if (cur_from < 0 && cur_to >= 0) cur_to = -1;
       }
 
-      const char* str_cur_s = str_cont.get(i).c_str();
-
       R_len_t cur_from2; // UTF-8 byte indices
       R_len_t cur_to2;   // UTF-8 byte indices
 
       stri__sub_get_indices(str_cont, i, cur_from, cur_to, cur_from2, cur_to2);
 
       if (cur_to2 > cur_from2) { // just copy
-         SET_STRING_ELT(ret, i, Rf_mkCharLenCE(str_cur_s+cur_from2, cur_to2-cur_from2, CE_UTF8));
+         ret_sub.set(i, i, cur_from2, cur_to2-cur_from2);
       }
       else {
          // maybe a warning here?
-         SET_STRING_ELT(ret, i, Rf_mkCharLen(NULL, 0));
+         ret_sub.set(i, i, 0, 0);
       }
    }
 
+   STRI__PROTECT(ret = ret_sub.toR());
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
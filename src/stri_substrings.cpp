@@ -0,0 +1,310 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "stri_stringi.h"
+#include "stri_substrings.h"
+
+#if defined(R_VERSION) && R_VERSION >= R_Version(3, 6, 0)
+#define STRI__SUBSTRINGS_ALTREP
+// older versions of R_ext/Altrep.h use `class` as an identifier
+#define class klass
+extern "C" {
+#include <R_ext/Altrep.h>
+}
+#undef class
+#endif
+
+
+#ifdef STRI__SUBSTRINGS_ALTREP
+
+/* The "stri_substrings" ALTREP class:
+ *    data1 = list(source character vector, INTSXP of triples)
+ *            or NULL once the vector has been fully materialized,
+ *    data2 = STRSXP with the CHARSXPs created so far or NULL.
+ *
+ * The CHARSXPs returned by Elt are kept in data2, so that they
+ * are protected from gc as long as the vector itself.
+ * As "" is used to mark the elements that have not been created yet,
+ * all the CHARSXPs are filled in (and data1 is dropped) before
+ * the data pointer is exposed or an element is modified.
+ */
+
+static R_altrep_class_t stri__substrings_class;
+static bool stri__substrings_registered = false;
+
+
+static R_xlen_t stri__substrings_Length(SEXP x)
+{
+   SEXP info = R_altrep_data1(x);
+   if (isNull(info))
+      return XLENGTH(R_altrep_data2(x));
+   return XLENGTH(VECTOR_ELT(info, 1))/3;
+}
+
+
+static SEXP stri__substrings_Elt(SEXP x, R_xlen_t i)
+{
+   SEXP info = R_altrep_data1(x);
+   if (isNull(info))
+      return STRING_ELT(R_altrep_data2(x), i);
+
+   SEXP slices = VECTOR_ELT(info, 1);
+   const int* s = INTEGER(slices)+3*i;
+   if (s[0] == NA_INTEGER)
+      return NA_STRING;
+   else if (s[2] <= 0)
+      return R_BlankString;
+
+   SEXP cache = R_altrep_data2(x);
+   if (isNull(cache)) {
+      cache = Rf_allocVector(STRSXP, XLENGTH(slices)/3); // all ""
+      R_set_altrep_data2(x, cache);
+   }
+
+   SEXP elt = STRING_ELT(cache, i);
+   if (elt == R_BlankString) {
+      elt = Rf_mkCharLenCE(CHAR(STRING_ELT(VECTOR_ELT(info, 0), s[0]))+s[1],
+         s[2], CE_UTF8);
+      SET_STRING_ELT(cache, i, elt);
+   }
+   return elt;
+}
+
+
+static SEXP stri__substrings_materialize(SEXP x)
+{
+   if (isNull(R_altrep_data1(x)))
+      return R_altrep_data2(x);
+
+   R_xlen_t n = stri__substrings_Length(x);
+   if (isNull(R_altrep_data2(x)))
+      R_set_altrep_data2(x, Rf_allocVector(STRSXP, n));
+
+   for (R_xlen_t i = 0; i < n; ++i) {
+      SEXP elt = stri__substrings_Elt(x, i);
+      SET_STRING_ELT(R_altrep_data2(x), i, elt);
+   }
+   R_set_altrep_data1(x, R_NilValue);
+   return R_altrep_data2(x);
+}
+
+
+static void stri__substrings_Set_elt(SEXP x, R_xlen_t i, SEXP v)
+{
+   SET_STRING_ELT(stri__substrings_materialize(x), i, v);
+}
+
+
+static void* stri__substrings_Dataptr(SEXP x, Rboolean /*writeable*/)
+{
+   return (void*)STRING_PTR_RO(stri__substrings_materialize(x));
+}
+
+
+static const void* stri__substrings_Dataptr_or_null(SEXP x)
+{
+   if (!isNull(R_altrep_data1(x)))
+      return NULL;
+   return (const void*)STRING_PTR_RO(R_altrep_data2(x));
+}
+
+
+static int stri__substrings_No_NA(SEXP x)
+{
+   SEXP info = R_altrep_data1(x);
+   if (isNull(info))
+      return 0; // might have been modified, we don't know
+   R_xlen_t n = stri__substrings_Length(x);
+   const int* s = INTEGER(VECTOR_ELT(info, 1));
+   for (R_xlen_t i = 0; i < n; ++i)
+      if (s[3*i] == NA_INTEGER)
+         return 0;
+   return 1;
+}
+
+
+static Rboolean stri__substrings_Inspect(SEXP x, int /*pre*/, int /*deep*/, int /*pvec*/,
+   void (* /*inspect_subtree*/)(SEXP, int, int, int))
+{
+   Rprintf(" stri_substrings (len=%d, materialized=%s)\n",
+      (int)stri__substrings_Length(x), isNull(R_altrep_data1(x))?"T":"F");
+   return TRUE;
+}
+
+#endif
+
+
+/** Register the ALTREP class used by StriSubstrings (if available)
+ *
+ * To be called by R_init_stringi.
+ *
+ * @param dll stringi's DLL info
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__substrings_init(DllInfo* dll)
+{
+#ifdef STRI__SUBSTRINGS_ALTREP
+   stri__substrings_class = R_make_altstring_class("stri_substrings", "stringi", dll);
+   R_set_altrep_Length_method(stri__substrings_class, stri__substrings_Length);
+   R_set_altrep_Inspect_method(stri__substrings_class, stri__substrings_Inspect);
+   R_set_altvec_Dataptr_method(stri__substrings_class, stri__substrings_Dataptr);
+   R_set_altvec_Dataptr_or_null_method(stri__substrings_class, stri__substrings_Dataptr_or_null);
+   R_set_altstring_Elt_method(stri__substrings_class, stri__substrings_Elt);
+   R_set_altstring_Set_elt_method(stri__substrings_class, stri__substrings_Set_elt);
+   R_set_altstring_No_NA_method(stri__substrings_class, stri__substrings_No_NA);
+   stri__substrings_registered = true;
+#endif
+}
+
+
+/** Count the code points in each string of a StriSubstrings-generated
+ *  vector without creating the CHARSXPs
+ *
+ * @param x character vector
+ * @return integer vector or R_NilValue if \code{x} is not
+ *    a lazy StriSubstrings result
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri__substrings_length(SEXP x)
+{
+#ifdef STRI__SUBSTRINGS_ALTREP
+   if (!stri__substrings_registered || !ALTREP(x)
+         || !R_altrep_inherits(x, stri__substrings_class)
+         || isNull(R_altrep_data1(x))) // materialized => might have been modified
+      return R_NilValue;
+
+   SEXP info = R_altrep_data1(x);
+   SEXP src = VECTOR_ELT(info, 0);
+   const int* s = INTEGER(VECTOR_ELT(info, 1));
+   R_len_t n = (R_len_t)stri__substrings_Length(x);
+
+   SEXP ret;
+   PROTECT(ret = Rf_allocVector(INTSXP, n));
+   int* retint = INTEGER(ret);
+   for (R_len_t i = 0; i < n; ++i, s += 3) {
+      if (s[0] == NA_INTEGER) {
+         retint[i] = NA_INTEGER;
+         continue;
+      }
+
+      SEXP curs = STRING_ELT(src, s[0]);
+      if (IS_ASCII(curs)) {
+         retint[i] = s[2];
+         continue;
+      }
+
+      const char* curs_s = CHAR(curs)+s[1];
+      R_len_t curs_n = s[2];
+      UChar32 c = 0;
+      R_len_t j = 0;
+      R_len_t k = 0;
+      while (c >= 0 && j < curs_n) {
+         U8_NEXT(curs_s, j, curs_n, c);
+         k++;
+      }
+
+      if (c < 0) { // invalid utf-8 sequence
+         Rf_warning(MSG__INVALID_UTF8);
+         retint[i] = NA_INTEGER;
+      }
+      else
+         retint[i] = k;
+   }
+   UNPROTECT(1);
+   return ret;
+#else
+   return R_NilValue;
+#endif
+}
+
+
+/** Allocate the result's storage
+ *
+ * @param src source character vector
+ * @param cont \code{src}'s contents
+ * @param n length of the result
+ * @param j if nonnegative, all the substrings will be taken
+ *    from the jth source string
+ * @return STRSXP or (in the lazy mode) INTSXP of length \code{3*n}
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP StriSubstrings::alloc(SEXP src, const StriContainerUTF8& cont, R_len_t n, R_len_t j)
+{
+#ifdef STRI__SUBSTRINGS_ALTREP
+   if (stri__substrings_registered && n >= STRI__SUBSTRINGS_MIN_LENGTH
+         && n <= R_LEN_T_MAX/3) {
+      bool inplace;
+      if (j >= 0)
+         inplace = cont.isNA(j) || cont.isCHARSXPData(j);
+      else {
+         inplace = true;
+         R_len_t nsrc = LENGTH(src);
+         for (R_len_t k = 0; inplace && k < nsrc; ++k)
+            inplace = cont.isNA(k) || cont.isCHARSXPData(k);
+      }
+
+      if (inplace)
+         return Rf_allocVector(INTSXP, 3*n);
+   }
+#endif
+   return Rf_allocVector(STRSXP, n);
+}
+
+
+/** Get the resulting character vector
+ *
+ * In the lazy mode, the source vector is marked as not mutable,
+ * as it will be referred to by the result.
+ *
+ * @return character vector (unprotected)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP StriSubstrings::toR()
+{
+#ifdef STRI__SUBSTRINGS_ALTREP
+   if (m_slices) {
+      MARK_NOT_MUTABLE(m_src);
+      SEXP info, ret;
+      PROTECT(info = Rf_allocVector(VECSXP, 2));
+      SET_VECTOR_ELT(info, 0, m_src);
+      SET_VECTOR_ELT(info, 1, m_data);
+      PROTECT(ret = R_new_altrep(stri__substrings_class, info, R_NilValue));
+      UNPROTECT(2);
+      return ret;
+   }
+#endif
+   return m_data; // alloc() yields an INTSXP only if ALTREP is available
+}
@@ -0,0 +1,126 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_substrings_h
+#define __stri_substrings_h
+
+#include "stri_stringi.h"
+#include "stri_container_utf8.h"
+
+
+/** results shorter than this are always materialized right away */
+#define STRI__SUBSTRINGS_MIN_LENGTH 128
+
+
+/**
+ * A builder for character vectors whose elements are substrings
+ * of the elements of another (UTF-8) character vector
+ *
+ * If R supports ALTREP string vectors and all the source strings
+ * are used in-place (no re-encoding, no BOMs), the result just keeps
+ * a reference to the source vector and a sequence of
+ * (source index, byte start, byte length) triples; CHARSXPs are
+ * created (and hashed into R's global CHARSXP cache) only when
+ * an element is actually accessed. Otherwise, an ordinary STRSXP
+ * is filled right away.
+ *
+ * Usage:
+ * \code
+ * STRI__PROTECT(ret = StriSubstrings::alloc(str, str_cont, n));
+ * StriSubstrings ret_sub(ret, str, str_cont);
+ * ... ret_sub.set(i, j, start, len); ... ret_sub.setNA(i); ...
+ * STRI__PROTECT(ret = ret_sub.toR());
+ * \endcode
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriSubstrings {
+
+   private:
+
+      SEXP m_data;                     // STRSXP or INTSXP of triples
+      int* m_slices;                   // INTEGER(m_data) or NULL if eager
+      SEXP m_src;                      // source character vector
+      R_len_t m_nsrc;                  // LENGTH(m_src)
+      const StriContainerUTF8* m_cont; // m_src's contents
+
+   public:
+
+      static SEXP alloc(SEXP src, const StriContainerUTF8& cont, R_len_t n, R_len_t j=-1);
+
+      StriSubstrings(SEXP data, SEXP src, const StriContainerUTF8& cont) {
+         m_data = data;
+         m_slices = (TYPEOF(data) == INTSXP) ? INTEGER(data) : NULL;
+         m_src = src;
+         m_nsrc = LENGTH(src);
+         m_cont = &cont;
+      }
+
+      /** Set the ith element to NA
+       *
+       * @param i index
+       */
+      inline void setNA(R_len_t i) {
+         if (m_slices) {
+            m_slices[3*i]   = NA_INTEGER;
+            m_slices[3*i+1] = 0;
+            m_slices[3*i+2] = 0;
+         }
+         else
+            SET_STRING_ELT(m_data, i, NA_STRING);
+      }
+
+      /** Set the ith element to a substring of the jth source string
+       *
+       * @param i index
+       * @param j source string's index (as in the container)
+       * @param start UTF-8 byte index
+       * @param len number of bytes
+       */
+      inline void set(R_len_t i, R_len_t j, R_len_t start, R_len_t len) {
+         if (m_slices) {
+            m_slices[3*i]   = j % m_nsrc;
+            m_slices[3*i+1] = start;
+            m_slices[3*i+2] = len;
+         }
+         else if (len <= 0)
+            SET_STRING_ELT(m_data, i, R_BlankString);
+         else
+            SET_STRING_ELT(m_data, i,
+               Rf_mkCharLenCE(m_cont->get(j).c_str()+start, len, CE_UTF8));
+      }
+
+      SEXP toR();
+};
+
+
+#endif
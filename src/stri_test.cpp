@@ -33,6 +33,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_container_utf16.h"
+#include "stri_brkiter.h"
 
 
 /** dummy fun to measure the performance of .Call
@@ -139,3 +140,25 @@ SEXP stri_test_UnicodeContainer8(SEXP str)
    return R_NilValue;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
 }
+
+
+/** Check if the ASCII fast path is used by a rule-based
+ *  break iterator *for testing only*
+ *
+ * @param opts_brkiter list
+ * @return single logical value
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_test_brkiter_ascii(SEXP opts_brkiter)
+{
+   StriBrkIterOptions opts_brkiter2(opts_brkiter, "word");
+
+   STRI__ERROR_HANDLER_BEGIN(0)
+   StriRuleBasedBreakIterator brkiter(opts_brkiter2);
+   SEXP ret;
+   STRI__PROTECT(ret = Rf_ScalarLogical(brkiter.isAsciiFastPath()));
+   STRI__UNPROTECT_ALL
+   return ret;
+   STRI__ERROR_HANDLER_END({ /* no-op on error */ })
+}
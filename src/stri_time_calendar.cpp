@@ -34,8 +34,11 @@
 #include "stri_container_utf8.h"
 #include "stri_container_double.h"
 #include "stri_container_integer.h"
+#include "stri_time_civil.h"
 #include <unicode/calendar.h>
 #include <unicode/gregocal.h>
+#include <cmath>
+#include <algorithm>
 
 
 /** Set POSIXct class on a given object
@@ -55,6 +58,103 @@ void stri__set_class_POSIXct(SEXP x) {
 }
 
 
+/** Get the range of finite values in a POSIXct object
+ *
+ * @param time_cont container
+ * @param from [out] smallest value, in milliseconds, clipped to
+ *    [STRI__TIME_CIVIL_MIN_MILLIS, STRI__TIME_CIVIL_MAX_MILLIS]
+ * @param to [out] largest value, clipped as above
+ * @param margin number of milliseconds to extend the range by
+ * @return false if there are no finite values in the range
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool stri__datetime_range(StriContainerDouble& time_cont,
+   double& from, double& to, double margin)
+{
+   from = R_PosInf;
+   to = R_NegInf;
+   R_len_t n = time_cont.get_n();
+   for (R_len_t i=0; i<n; ++i) {
+      if (time_cont.isNA(i)) continue;
+      double t = (double)((UDate)(time_cont.get(i)*1000.0));
+      if (!R_FINITE(t)) continue;
+      if (t < from) from = t;
+      if (t > to)   to = t;
+   }
+   from = std::max(from-margin, (double)STRI__TIME_CIVIL_MIN_MILLIS);
+   to   = std::min(to+margin,   (double)STRI__TIME_CIVIL_MAX_MILLIS);
+   return (from <= to);
+}
+
+
+/** Compute the fields of a Gregorian calendar, as in stri_datetime_fields
+ *
+ * The same as ICU's Calendar::computeFields and Calendar::computeWeekFields.
+ *
+ * @param local local time, in milliseconds since 1970-01-01 00:00:00,
+ *    in [STRI__TIME_CIVIL_MIN_MILLIS, STRI__TIME_CIVIL_MAX_MILLIS)
+ * @param first_dow the first day of the week, 1 (Sunday) to 7
+ * @param min_days the minimal number of days in the first week of a year
+ * @param fields [out] 14 values, see stri_datetime_fields
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__datetime_fields_gregorian(double local, int first_dow, int min_days, int* fields)
+{
+   int days = (int)floor(local/86400000.0);
+   int millis_in_day = (int)(local - (double)days*86400000.0);
+   int year, month, day;
+   stri__time_civil_from_days(days, year, month, day);
+
+   int hour = millis_in_day/3600000;
+   int dow = ((days%7) + 11)%7 + 1; // 1970-01-01 was a Thursday (5)
+   int doy = days - stri__time_days_from_civil(year, 1, 1) + 1;
+   int year_length = stri__time_days_from_civil(year+1, 1, 1) - stri__time_days_from_civil(year, 1, 1);
+
+   // Calendar::computeWeekFields
+   int rel_dow = (dow + 7 - first_dow)%7;
+   int rel_dow_jan1 = (dow - doy + 7001 - first_dow)%7;
+   int woy = (doy - 1 + rel_dow_jan1)/7;
+   if ((7 - rel_dow_jan1) >= min_days) ++woy;
+   if (woy == 0) {
+      // Calendar::weekNumber for the last day of the previous year
+      int prev_doy = doy + stri__time_days_from_civil(year, 1, 1) - stri__time_days_from_civil(year-1, 1, 1);
+      int start = (dow - first_dow - prev_doy + 1)%7;
+      if (start < 0) start += 7;
+      woy = (prev_doy + start - 1)/7;
+      if ((7 - start) >= min_days) ++woy;
+   }
+   else if (doy >= year_length - 5) {
+      int last_rel_dow = (rel_dow + year_length - doy)%7;
+      if (last_rel_dow < 0) last_rel_dow += 7;
+      if ((6 - last_rel_dow) >= min_days && (doy + 7 - rel_dow) > year_length)
+         woy = 1;
+   }
+
+   // Calendar::weekNumber for the day of the month
+   int start = (dow - first_dow - day + 1)%7;
+   if (start < 0) start += 7;
+   int wom = (day + start - 1)/7;
+   if ((7 - start) >= min_days) ++wom;
+
+   fields[0]  = year;
+   fields[1]  = month;
+   fields[2]  = day;
+   fields[3]  = hour;
+   fields[4]  = (millis_in_day/60000)%60;
+   fields[5]  = (millis_in_day/1000)%60;
+   fields[6]  = millis_in_day%1000;
+   fields[7]  = woy;
+   fields[8]  = wom;
+   fields[9]  = doy;
+   fields[10] = dow;
+   fields[11] = hour%12;
+   fields[12] = hour/12 + 1;
+   fields[13] = 2; // AD
+}
+
+
 /** Get current date-time
  *
  * @return POSIXct
@@ -84,6 +184,8 @@ SEXP stri_datetime_now()
  *
  * @version 0.5-1 (Marek Gagolewski, 2014-12-30)
  * @version 0.5-1 (Marek Gagolewski, 2015-03-06) tz arg added
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) use StriTimeZoneOffsets
+ *    to avoid calling ICU in common cases
  */
 SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale) {
    PROTECT(time = stri_prepare_arg_POSIXct(time, "time"));
@@ -102,6 +204,7 @@ SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale)
    TimeZone* tz_val = stri__prepare_arg_timezone(tz, "tz", true/*allowdefault*/);
 
    Calendar* cal = NULL;
+   StriTimeZoneOffsets* offsets = NULL;
    STRI__ERROR_HANDLER_BEGIN(3)
    StriContainerDouble time_cont(time, vectorize_length);
    StriContainerInteger value_cont(value, vectorize_length);
@@ -126,6 +229,31 @@ SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale)
    cal->adoptTimeZone(tz_val);
    tz_val = NULL; /* The Calendar takes ownership of the TimeZone. */
 
+   // Calendar::add() adds a multiple of the unit to the time
+   // for hours and smaller units; for days and weeks, the wall time is
+   // additionally kept, which matters only if the UTC offset changes.
+   // For months and years in the Gregorian calendar, we use the zone's
+   // transition table and do the arithmetic on the local time.
+   const double unit_millis[] = {0.0, 0.0, 7.0*86400000.0, 86400000.0,
+      3600000.0, 60000.0, 1000.0, 1.0};
+   bool gregorian = (strcmp(cal->getType(), "gregorian") == 0);
+   if (units_cur == 2 || units_cur == 3 || (gregorian && units_cur <= 1)) {
+      double max_value = 0.0;
+      for (R_len_t i=0; i<value_cont.get_n(); ++i) {
+         if (!value_cont.isNA(i))
+            max_value = std::max(max_value, fabs((double)value_cont.get(i)));
+      }
+      double margin;
+      if (units_cur == 0)      margin = max_value*366.0*86400000.0;
+      else if (units_cur == 1) margin = max_value*31.0*86400000.0;
+      else                     margin = max_value*unit_millis[units_cur];
+      double from, to;
+      if (stri__datetime_range(time_cont, from, to, margin + 2.0*86400000.0)) {
+         offsets = new StriTimeZoneOffsets(cal->getTimeZone(), from, to);
+         if (!offsets) throw StriException(MSG__MEM_ALLOC_ERROR);
+      }
+   }
+
    SEXP ret;
    STRI__PROTECT(ret = Rf_allocVector(REALSXP, vectorize_length));
    double* ret_val = REAL(ret);
@@ -134,6 +262,52 @@ SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale)
          ret_val[i] = NA_REAL;
          continue;
       }
+
+      double t = (double)((UDate)(time_cont.get(i)*1000.0));
+      int value = value_cont.get(i);
+      if (t >= STRI__TIME_CIVIL_MIN_MILLIS && t < STRI__TIME_CIVIL_MAX_MILLIS) {
+         if (value == 0) {
+            ret_val[i] = t/1000.0;
+            continue;
+         }
+
+         if (units_cur >= 2) {
+            double r = t + (double)value*unit_millis[units_cur];
+            if (r >= STRI__TIME_CIVIL_MIN_MILLIS && r < STRI__TIME_CIVIL_MAX_MILLIS && (units_cur >= 4 ||
+                  (offsets && offsets->covers(t) && offsets->covers(r) &&
+                   offsets->getOffset(t) == offsets->getOffset(r)))) {
+               ret_val[i] = r/1000.0;
+               continue;
+            }
+         }
+         else if (offsets && offsets->covers(t) && value >= -120000 && value <= 120000) {
+            int offset = offsets->getOffset(t);
+            double local = t + offset;
+            int days = (int)floor(local/86400000.0);
+            int millis_in_day = (int)(local - (double)days*86400000.0);
+            int year, month, day;
+            stri__time_civil_from_days(days, year, month, day);
+            if (units_cur == 0)
+               year += value;
+            else {
+               int m = month - 1 + value;
+               int q = (m >= 0) ? m/12 : -((-m + 11)/12);
+               year += q;
+               month = m - 12*q + 1;
+            }
+            if (year >= 1583 && year <= 9999) {
+               day = std::min(day, stri__time_days_in_month(year, month)); // pinField
+               double r = (double)stri__time_days_from_civil(year, month, day)*86400000.0
+                  + millis_in_day - offset;
+               if (offsets->getOffset(r) == offset &&
+                     !offsets->hasTransitions(r - 86400000.0, r + 86400000.0)) {
+                  ret_val[i] = r/1000.0;
+                  continue;
+               }
+            }
+         }
+      }
+
       status = U_ZERO_ERROR;
       cal->setTime((UDate)(time_cont.get(i)*1000.0), status);
       STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
@@ -151,11 +325,13 @@ SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale)
    stri__set_class_POSIXct(ret);
    if (tz_val) { delete tz_val; tz_val = NULL; }
    if (cal) { delete cal; cal = NULL; }
+   if (offsets) { delete offsets; offsets = NULL; }
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END({
       if (tz_val) { delete tz_val; tz_val = NULL; }
       if (cal) { delete cal; cal = NULL; }
+      if (offsets) { delete offsets; offsets = NULL; }
    })
 }
 
@@ -171,6 +347,8 @@ SEXP stri_datetime_add(SEXP time, SEXP value, SEXP units, SEXP tz, SEXP locale)
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-01-01)
  * @version 0.5-1 (Marek Gagolewski, 2015-03-03) tz arg added
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) Gregorian calendar:
+ *    use StriTimeZoneOffsets and stri__datetime_fields_gregorian
  */
 SEXP stri_datetime_fields(SEXP time, SEXP tz, SEXP locale) {
    PROTECT(time = stri_prepare_arg_POSIXct(time, "time"));
@@ -180,6 +358,7 @@ SEXP stri_datetime_fields(SEXP time, SEXP tz, SEXP locale) {
 
    TimeZone* tz_val = stri__prepare_arg_timezone(tz, "tz", true/*allowdefault*/);
    Calendar* cal = NULL;
+   StriTimeZoneOffsets* offsets = NULL;
    STRI__ERROR_HANDLER_BEGIN(2)
    R_len_t vectorize_length = LENGTH(time);
    StriContainerDouble time_cont(time, vectorize_length);
@@ -197,6 +376,20 @@ SEXP stri_datetime_fields(SEXP time, SEXP tz, SEXP locale) {
    for (R_len_t j=0; j<STRI__FIELDS_NUM; ++j)
       SET_VECTOR_ELT(ret, j, Rf_allocVector(INTSXP, vectorize_length));
 
+   // Gregorian calendar: determine the UTC offsets from the zone's
+   // transition table and compute the fields without ICU
+   int first_dow = 1, min_days = 1;
+   double from, to;
+   if (strcmp(cal->getType(), "gregorian") == 0 &&
+         stri__datetime_range(time_cont, from, to, 86400000.0)) {
+      first_dow = (int)cal->getFirstDayOfWeek(status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      min_days = (int)cal->getMinimalDaysInFirstWeek();
+      offsets = new StriTimeZoneOffsets(cal->getTimeZone(), from, to);
+      if (!offsets) throw StriException(MSG__MEM_ALLOC_ERROR);
+   }
+
+   int fields[STRI__FIELDS_NUM];
    for (R_len_t i=0; i<vectorize_length; ++i) {
       if (time_cont.isNA(i)) {
          for (R_len_t j=0; j<STRI__FIELDS_NUM; ++j)
@@ -204,6 +397,17 @@ SEXP stri_datetime_fields(SEXP time, SEXP tz, SEXP locale) {
          continue;
       }
 
+      double t = (double)((UDate)(time_cont.get(i)*1000.0));
+      if (offsets && offsets->covers(t)) {
+         double local = t + offsets->getOffset(t);
+         if (local >= STRI__TIME_CIVIL_MIN_MILLIS && local < STRI__TIME_CIVIL_MAX_MILLIS) {
+            stri__datetime_fields_gregorian(local, first_dow, min_days, fields);
+            for (R_len_t j=0; j<STRI__FIELDS_NUM; ++j)
+               INTEGER(VECTOR_ELT(ret, j))[i] = fields[j];
+            continue;
+         }
+      }
+
       status = U_ZERO_ERROR;
       cal->setTime((UDate)(time_cont.get(i)*1000.0), status);
       STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
@@ -251,11 +455,13 @@ SEXP stri_datetime_fields(SEXP time, SEXP tz, SEXP locale) {
       "WeekOfYear", "WeekOfMonth","DayOfYear", "DayOfWeek", "Hour12", "AmPm", "Era");
    if (tz_val) { delete tz_val; tz_val = NULL; }
    if (cal) { delete cal; cal = NULL; }
+   if (offsets) { delete offsets; offsets = NULL; }
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END({
       if (tz_val) { delete tz_val; tz_val = NULL; }
       if (cal) { delete cal; cal = NULL; }
+      if (offsets) { delete offsets; offsets = NULL; }
    })
 }
 
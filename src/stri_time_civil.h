@@ -0,0 +1,159 @@
+/* This file is part of the 'stringi' package for R.
+ * Copyright (c) 2013-2017, Marek Gagolewski and other contributors.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING,
+ * BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef __stri_time_civil_h
+#define __stri_time_civil_h
+
+#include <unicode/timezone.h>
+#include <vector>
+
+
+/* The range of (local) times in milliseconds since 1970-01-01 00:00:00,
+ * [1583-01-01, 10000-01-01), for which ICU's GregorianCalendar
+ * agrees with the proleptic Gregorian calendar (the Julian one
+ * is used before 1582-10-15)
+ */
+#define STRI__TIME_CIVIL_MIN_MILLIS (-12212553600000.0)
+#define STRI__TIME_CIVIL_MAX_MILLIS (253402300800000.0)
+
+
+/* Proleptic Gregorian calendar arithmetic, see
+ * H. Hinnant, chrono-Compatible Low-Level Date Algorithms,
+ * http://howardhinnant.github.io/date_algorithms.html
+ */
+
+
+/** Number of days since 1970-01-01
+ *
+ * @param y year
+ * @param m month, 1..12
+ * @param d day, 1..31
+ * @return number of days (negative for dates before 1970-01-01)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline int stri__time_days_from_civil(int y, int m, int d)
+{
+   y -= (m <= 2);
+   const int era = (y >= 0 ? y : y-399)/400;
+   const int yoe = y - era*400;                               // [0, 399]
+   const int doy = (153*(m + (m > 2 ? -3 : 9)) + 2)/5 + d-1;  // [0, 365]
+   const int doe = yoe*365 + yoe/4 - yoe/100 + doy;           // [0, 146096]
+   return era*146097 + doe - 719468;
+}
+
+
+/** Year, month, and day from the number of days since 1970-01-01
+ *
+ * @param z number of days
+ * @param y [out] year
+ * @param m [out] month, 1..12
+ * @param d [out] day, 1..31
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline void stri__time_civil_from_days(int z, int& y, int& m, int& d)
+{
+   z += 719468;
+   const int era = (z >= 0 ? z : z - 146096)/146097;
+   const int doe = z - era*146097;                                 // [0, 146096]
+   const int yoe = (doe - doe/1460 + doe/36524 - doe/146096)/365;  // [0, 399]
+   const int doy = doe - (365*yoe + yoe/4 - yoe/100);              // [0, 365]
+   const int mp  = (5*doy + 2)/153;                                // [0, 11]
+   d = doy - (153*mp + 2)/5 + 1;
+   m = mp + (mp < 10 ? 3 : -9);
+   y = yoe + era*400 + (m <= 2);
+}
+
+
+/** Number of days in a month
+ *
+ * @param y year
+ * @param m month, 1..12
+ * @return 28..31
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+inline int stri__time_days_in_month(int y, int m)
+{
+   static const int dim[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+   if (m == 2 && (y%4 == 0 && (y%100 != 0 || y%400 == 0)))
+      return 29;
+   return dim[m-1];
+}
+
+
+/**
+ * UTC offsets of a time zone over a given time range,
+ * determined from the zone's transition table
+ *
+ * Finding the offset (see getOffset()) boils down to
+ * a binary search, which is much faster than ICU's
+ * Calendar::setTime() followed by Calendar::get().
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriTimeZoneOffsets {
+   private:
+
+      double from;                      // in milliseconds
+      double to;
+      int first_offset;                 // in effect at `from`
+      std::vector<double> trans_time;   // increasing, in (from, to]
+      std::vector<int> trans_offset;    // in effect since trans_time[k]
+      bool valid;
+
+   public:
+
+      StriTimeZoneOffsets(const TimeZone& tz, double from, double to);
+
+      /** @return false if the zone's transitions cannot be determined */
+      bool isValid() const { return valid; }
+
+      /** @return true if the offset does not change over [from, to] */
+      bool isFixed() const { return valid && trans_time.empty(); }
+
+      /** @return true if t is in [from, to] */
+      bool covers(double t) const { return valid && t >= from && t <= to; }
+
+      int getOffset(double t) const;
+      bool hasTransitions(double t1, double t2) const;
+};
+
+
+class StriContainerDouble;
+
+// stri_time_calendar.cpp
+bool stri__datetime_range(StriContainerDouble& time_cont,
+   double& from, double& to, double margin=0.0);
+
+#endif
@@ -37,28 +37,34 @@
 #include <unicode/calendar.h>
 #include <unicode/gregocal.h>
 #include <unicode/smpdtfmt.h>
+#include <unicode/basictz.h>
+#include <unicode/tztrans.h>
+#include <unicode/numsys.h>
+#include "stri_time_civil.h"
+#include <string>
+#include <deque>
+#include <vector>
+#include <cmath>
 
 
-/**
- * Format date-time objects
- *
- * @param time
- * @param format
- * @param tz
- * @param locale
- *
- * @return character vector
+/** maximal number of formatters kept in StriDateFormatCache */
+#define STRI__DATEFORMAT_CACHE_SIZE 16
+
+
+/** Create a date formatter
  *
- * @version 0.5-1 (Marek Gagolewski, 2015-01-05)
+ * @param format_val format string or one of the predefined style names
+ * @param locale_val locale ID
+ * @param is_pattern [out] whether format_val is a pattern (and not a style name)
+ * @param status [out] ICU status
+ * @return new DateFormat object or NULL
  *
- * @version 0.5-1 (Marek Gagolewski, 2015-02-22)
- *    use tz
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    code moved from stri_datetime_format and stri_datetime_parse
  */
-SEXP stri_datetime_format(SEXP time, SEXP format, SEXP tz, SEXP locale) {
-   PROTECT(time = stri_prepare_arg_POSIXct(time, "time"));
-   const char* locale_val = stri__prepare_arg_locale(locale, "locale", true);
-   const char* format_val = stri__prepare_arg_string_1_notNA(format, "format");
-
+DateFormat* stri__datetime_createformat(const char* format_val,
+   const char* locale_val, bool& is_pattern, UErrorCode& status)
+{
    // "format" may be one of:
    const char* format_opts[] = {
       "date_full", "date_long", "date_medium", "date_short",
@@ -70,73 +76,714 @@ SEXP stri_datetime_format(SEXP time, SEXP format, SEXP tz, SEXP locale) {
       NULL};
    int format_cur = stri__match_arg(format_val, format_opts);
 
-   TimeZone* tz_val = stri__prepare_arg_timezone(tz, "tz", true/*allowdefault*/);
-   Calendar* cal = NULL;
-   DateFormat* fmt = NULL;
-   STRI__ERROR_HANDLER_BEGIN(1)
-   R_len_t vectorize_length = LENGTH(time);
-   StriContainerDouble time_cont(time, vectorize_length);
-   UnicodeString format_str(format_val);
+   is_pattern = (format_cur < 0);
+   if (format_cur < 0)
+      return new SimpleDateFormat(UnicodeString(format_val),
+         Locale::createFromName(locale_val), status);
+
+   DateFormat::EStyle style = DateFormat::kNone;
+   switch (format_cur % 8) {
+      case 0:  style = DateFormat::kFull; break;
+      case 1:  style = DateFormat::kLong; break;
+      case 2:  style = DateFormat::kMedium; break;
+      case 3:  style = DateFormat::kShort; break;
+      case 4:  style = DateFormat::kFullRelative; break;
+      case 5:  style = DateFormat::kLongRelative; break;
+      case 6:  style = DateFormat::kMediumRelative; break;
+      case 7:  style = DateFormat::kShortRelative; break;
+      default: style = DateFormat::kNone; break;
+   }
+
+   /* ICU 54.1: Relative time styles are not currently supported.  */
+   switch (format_cur / 8) {
+      case 0:
+         return DateFormat::createDateInstance(style,
+            Locale::createFromName(locale_val));
+
+      case 1:
+         return DateFormat::createTimeInstance(
+            (DateFormat::EStyle)(style & ~DateFormat::kRelative),
+            Locale::createFromName(locale_val));
+
+      case 2:
+         return DateFormat::createDateTimeInstance(style,
+            (DateFormat::EStyle)(style & ~DateFormat::kRelative),
+            Locale::createFromName(locale_val));
+
+      default:
+         return NULL;
+   }
+}
+
+
+/**
+ * A compiled date-time pattern that consists solely of numeric fields
+ * (e.g., ISO 8601 or RFC 3339 ones, like \code{yyyy-MM-dd'T'HH:mm:ss.SSSXXX}),
+ * to be used with the proleptic Gregorian calendar
+ *
+ * Formatting and parsing is then done without ICU, directly on
+ * ASCII strings. Years from outside of [1583, 9999] (the Gregorian
+ * calendar is used since 1582-10-15) are not supported, and so
+ * are strings that are not of the exact form produced by format();
+ * in such cases ICU should be called. parse() additionally requires
+ * the time zone to have a fixed UTC offset; for format(), the offsets
+ * may be provided via StriTimeZoneOffsets.
+ *
+ * Supported fields: y, u (but not yy, uu), M, MM, d, dd, H, HH,
+ * m, mm, s, ss, S+, Z, ZZ, ZZZ, ZZZZZ, X, XX, XXX, x, xx, xxx.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriDateFormatFast {
+   private:
+
+      struct Token {
+         char field;          // 0 for a literal
+         int count;
+         std::string literal; // ASCII
+      };
+
+      std::vector<Token> tokens;
+      bool fixed;     // is the UTC offset fixed over [1583, 9999]?
+      int offset;     // the UTC offset in milliseconds, if fixed
+      bool zoned;     // are there any Z, X, or x fields?
+      bool parsable;  // are all the fields needed by parse() present?
+
+      StriDateFormatFast() { }
+
+      static void appendNumber(std::string& out, int value, int mindigits);
+      static bool parseNumber(const char* s, R_len_t n, R_len_t& j,
+         int mindigits, int maxdigits, int& value);
+
+   public:
+
+      static StriDateFormatFast* create(const char* format_val,
+         const char* locale_val, const Calendar* cal);
+
+      /** @return true if the UTC offset is fixed, i.e.,
+       * there is no need to pass StriTimeZoneOffsets to format() */
+      bool isFixed() const { return fixed; }
+
+      bool format(double time, const StriTimeZoneOffsets* offsets, std::string& out) const;
+      bool parse(const char* s, R_len_t n, int millisecond, double& time) const;
+};
 
+
+/** Compile a date-time pattern
+ *
+ * @param format_val pattern
+ * @param locale_val locale ID
+ * @param cal calendar to be used with the pattern
+ * @return new object or NULL if the fast path cannot be used
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriDateFormatFast* StriDateFormatFast::create(const char* format_val,
+   const char* locale_val, const Calendar* cal)
+{
+   if (strcmp(cal->getType(), "gregorian") != 0)
+      return NULL;
+
+   // numeric fields are formatted with the locale's default digits
    UErrorCode status = U_ZERO_ERROR;
-   if (format_cur >= 0) {
-      DateFormat::EStyle style = DateFormat::kNone;
-      switch (format_cur % 8) {
-         case 0:  style = DateFormat::kFull; break;
-         case 1:  style = DateFormat::kLong; break;
-         case 2:  style = DateFormat::kMedium; break;
-         case 3:  style = DateFormat::kShort; break;
-         case 4:  style = DateFormat::kFullRelative; break;
-         case 5:  style = DateFormat::kLongRelative; break;
-         case 6:  style = DateFormat::kMediumRelative; break;
-         case 7:  style = DateFormat::kShortRelative; break;
-         default: style = DateFormat::kNone; break;
+   NumberingSystem* ns = NumberingSystem::createInstance(
+      Locale::createFromName(locale_val), status);
+   bool latn = (U_SUCCESS(status) && ns && strcmp(ns->getName(), "latn") == 0);
+   if (ns) delete ns;
+   if (!latn) return NULL;
+
+   // is the UTC offset fixed over [1583, 9999]?
+   const TimeZone& tz = cal->getTimeZone();
+   const BasicTimeZone* btz = dynamic_cast<const BasicTimeZone*>(&tz);
+   if (!btz) return NULL;
+   UDate from = (UDate)stri__time_days_from_civil(1583, 1, 1)*86400000.0;
+   UDate to   = (UDate)stri__time_days_from_civil(10000, 1, 2)*86400000.0;
+   TimeZoneTransition trans;
+   int32_t raw_offset, dst_offset;
+   status = U_ZERO_ERROR;
+   tz.getOffset(from, false, raw_offset, dst_offset, status);
+   if (U_FAILURE(status)) return NULL;
+
+   StriDateFormatFast* fast = new StriDateFormatFast();
+   if (!fast) return NULL;
+   fast->fixed = !(btz->getNextTransition(from, true, trans) && trans.getTime() <= to);
+   fast->offset = raw_offset + dst_offset;
+   fast->zoned = false;
+
+   int nfields[128] = {0};
+   const char* s = format_val;
+   while (*s) {
+      Token tok;
+      tok.field = 0;
+      tok.count = 0;
+      if (*s == '\'') {
+         if (s[1] == '\'') { // escaped apostrophe
+            tok.literal = "'";
+            s += 2;
+         }
+         else { // quoted text
+            ++s;
+            while (true) {
+               if (!*s) { delete fast; return NULL; } // unterminated
+               if (*s == '\'') {
+                  if (s[1] != '\'') { ++s; break; }
+                  ++s;
+               }
+               tok.literal.push_back(*s);
+               ++s;
+            }
+         }
+      }
+      else if ((*s >= 'a' && *s <= 'z') || (*s >= 'A' && *s <= 'Z')) {
+         tok.field = *s;
+         while (*s == tok.field) { ++s; ++tok.count; }
+         bool ok;
+         switch (tok.field) {
+            case 'y': case 'u':
+               ok = (tok.count != 2 && tok.count <= 9); break;
+            case 'M': case 'd': case 'H': case 'm': case 's':
+               ok = (tok.count <= 2); break;
+            case 'S':
+               ok = (tok.count <= 9); break;
+            case 'Z':
+               ok = (tok.count <= 3 || tok.count == 5); break;
+            case 'X': case 'x':
+               ok = (tok.count <= 3); break;
+            default:
+               ok = false;
+         }
+         if (!ok) { delete fast; return NULL; }
+         nfields[(int)tok.field]++;
+      }
+      else {
+         tok.literal.push_back(*s);
+         ++s;
+      }
+
+      for (size_t k=0; k<tok.literal.size(); ++k) {
+         if ((unsigned char)tok.literal[k] >= 128) { delete fast; return NULL; }
       }
 
-      /* ICU 54.1: Relative time styles are not currently supported.  */
-      switch (format_cur / 8) {
+      if (tok.field == 0 && !fast->tokens.empty() && fast->tokens.back().field == 0)
+         fast->tokens.back().literal += tok.literal;
+      else if (tok.field != 0 || !tok.literal.empty())
+         fast->tokens.push_back(tok);
+   }
+
+   // parse() supports each of the fields given exactly once,
+   fast->zoned = (nfields['Z'] + nfields['X'] + nfields['x'] > 0);
+
+   // fixed-width years, and 1-digit fields followed by a non-digit
+   fast->parsable = fast->fixed && (nfields['y'] + nfields['u'] == 1 && nfields['M'] == 1 &&
+      nfields['d'] == 1 && nfields['H'] == 1 && nfields['m'] == 1 &&
+      nfields['s'] == 1 && nfields['S'] <= 1 &&
+      nfields['Z'] + nfields['X'] + nfields['x'] <= 1);
+   for (size_t k=0; fast->parsable && k<fast->tokens.size(); ++k) {
+      const Token& tok = fast->tokens[k];
+      if ((tok.field == 'y' || tok.field == 'u') && tok.count != 4)
+         fast->parsable = false;
+      else if (tok.field == 'S' && tok.count > 3)
+         fast->parsable = false;
+      else if (tok.field != 0 && tok.count == 1 && tok.field != 'S' &&
+            tok.field != 'Z' && tok.field != 'X' && tok.field != 'x') {
+         if (k+1 >= fast->tokens.size() || fast->tokens[k+1].field != 0 ||
+               (fast->tokens[k+1].literal[0] >= '0' && fast->tokens[k+1].literal[0] <= '9'))
+            fast->parsable = false;
+      }
+   }
+
+   return fast;
+}
+
+
+/** Append a non-negative number padded with zeros
+ *
+ * @param out [out] output buffer
+ * @param value non-negative number
+ * @param mindigits minimal number of digits
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriDateFormatFast::appendNumber(std::string& out, int value, int mindigits)
+{
+   char buf[16];
+   int k = 0;
+   do {
+      buf[k++] = (char)('0' + value%10);
+      value /= 10;
+   } while (value > 0);
+   while (k < mindigits) buf[k++] = '0';
+   while (k > 0) out.push_back(buf[--k]);
+}
+
+
+/** Parse a non-negative number
+ *
+ * @param s string
+ * @param n number of bytes in s
+ * @param j [in/out] current position
+ * @param mindigits minimal number of digits
+ * @param maxdigits maximal number of digits
+ * @param value [out] parsed number
+ * @return true on success
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriDateFormatFast::parseNumber(const char* s, R_len_t n, R_len_t& j,
+   int mindigits, int maxdigits, int& value)
+{
+   int k = 0;
+   value = 0;
+   while (k < maxdigits && j < n && s[j] >= '0' && s[j] <= '9') {
+      value = value*10 + (s[j]-'0');
+      ++j;
+      ++k;
+   }
+   return (k >= mindigits);
+}
+
+
+/** Format a date-time
+ *
+ * @param time number of seconds since 1970-01-01 00:00:00 UTC
+ * @param offsets UTC offsets to use if the zone's offset is not fixed;
+ *    may be NULL
+ * @param out [out] output buffer, cleared first
+ * @return false if time is out of the supported range
+ *    or the UTC offset is not known
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriDateFormatFast::format(double time, const StriTimeZoneOffsets* offsets,
+   std::string& out) const
+{
+   // the same arithmetic as in Calendar::setTime and Calendar::computeFields
+   double t = (double)((UDate)(time*1000.0));
+   int offset = this->offset;
+   if (!fixed) {
+      if (!offsets || !offsets->covers(t)) return false;
+      offset = offsets->getOffset(t);
+   }
+   if (zoned && offset%60000 != 0) // ICU outputs seconds then
+      return false;
+   double local = t + offset;
+   if (!(local >= STRI__TIME_CIVIL_MIN_MILLIS && local < STRI__TIME_CIVIL_MAX_MILLIS))
+      return false;
+   double days = floor(local/86400000.0);
+   int millis_in_day = (int)(local - days*86400000.0);
+   int year, month, day;
+   stri__time_civil_from_days((int)days, year, month, day);
+
+   out.clear();
+   for (size_t k=0; k<tokens.size(); ++k) {
+      const Token& tok = tokens[k];
+      int value;
+      switch (tok.field) {
          case 0:
-            fmt = DateFormat::createDateInstance(style,
-               Locale::createFromName(locale_val));
+            out += tok.literal;
+            break;
+
+         case 'y': case 'u':
+            appendNumber(out, year, tok.count);
             break;
 
-         case 1:
-            fmt = DateFormat::createTimeInstance(
-               (DateFormat::EStyle)(style & ~DateFormat::kRelative),
-               Locale::createFromName(locale_val));
+         case 'M':
+            appendNumber(out, month, tok.count);
             break;
 
-         case 2:
-            fmt = DateFormat::createDateTimeInstance(style,
-               (DateFormat::EStyle)(style & ~DateFormat::kRelative),
-               Locale::createFromName(locale_val));
+         case 'd':
+            appendNumber(out, day, tok.count);
             break;
 
-         default:
-            fmt = NULL;
+         case 'H':
+            appendNumber(out, millis_in_day/3600000, tok.count);
             break;
 
+         case 'm':
+            appendNumber(out, (millis_in_day/60000)%60, tok.count);
+            break;
+
+         case 's':
+            appendNumber(out, (millis_in_day/1000)%60, tok.count);
+            break;
+
+         case 'S': // fractional seconds, truncated or padded on the right
+            value = millis_in_day%1000;
+            if (tok.count == 1)      appendNumber(out, value/100, 1);
+            else if (tok.count == 2) appendNumber(out, value/10, 2);
+            else {
+               appendNumber(out, value, 3);
+               for (int c=3; c<tok.count; ++c) out.push_back('0');
+            }
+            break;
+
+         case 'Z': case 'X': case 'x': {
+            if (offset == 0 && (tok.field == 'X' || (tok.field == 'Z' && tok.count == 5))) {
+               out.push_back('Z');
+               break;
+            }
+            int hours   = (offset < 0 ? -offset : offset)/3600000;
+            int minutes = ((offset < 0 ? -offset : offset)/60000)%60;
+            out.push_back(offset < 0 ? '-' : '+');
+            appendNumber(out, hours, 2);
+            if (tok.field == 'Z' && tok.count == 5) {
+               out.push_back(':');
+               appendNumber(out, minutes, 2);
+            }
+            else if (tok.field == 'Z' || tok.count >= 2 || minutes != 0) {
+               if (tok.field != 'Z' && tok.count == 3) out.push_back(':');
+               appendNumber(out, minutes, 2);
+            }
+            break;
+         }
       }
    }
-   else
-      fmt = new SimpleDateFormat(format_str, Locale::createFromName(locale_val), status);
-   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+   return true;
+}
 
-   status = U_ZERO_ERROR;
-   cal = Calendar::createInstance(locale_val, status);
-   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
 
-   cal->adoptTimeZone(tz_val);
-   tz_val = NULL; /* The Calendar takes ownership of the TimeZone. */
+/** Parse a date-time
+ *
+ * @param s string
+ * @param n number of bytes in s
+ * @param millisecond milliseconds to use if there is no S field
+ * @param time [out] number of seconds since 1970-01-01 00:00:00 UTC
+ * @return false if s is not of the exact form produced by format()
+ *    (ICU should be called then)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriDateFormatFast::parse(const char* s, R_len_t n, int millisecond, double& time) const
+{
+   if (!parsable) return false;
+
+   int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+   int cur_offset = offset;
+   R_len_t j = 0;
+   for (size_t k=0; k<tokens.size(); ++k) {
+      const Token& tok = tokens[k];
+      int mindigits = (tok.count == 1) ? 1 : tok.count;
+      int maxdigits = (tok.count == 1) ? 2 : tok.count;
+      switch (tok.field) {
+         case 0:
+            if (n-j < (R_len_t)tok.literal.size() ||
+                  memcmp(s+j, tok.literal.data(), tok.literal.size()) != 0)
+               return false;
+            j += (R_len_t)tok.literal.size();
+            break;
+
+         case 'y': case 'u':
+            if (!parseNumber(s, n, j, 4, 4, year)) return false;
+            break;
+
+         case 'M':
+            if (!parseNumber(s, n, j, mindigits, maxdigits, month)) return false;
+            break;
+
+         case 'd':
+            if (!parseNumber(s, n, j, mindigits, maxdigits, day)) return false;
+            break;
+
+         case 'H':
+            if (!parseNumber(s, n, j, mindigits, maxdigits, hour)) return false;
+            break;
+
+         case 'm':
+            if (!parseNumber(s, n, j, mindigits, maxdigits, minute)) return false;
+            break;
+
+         case 's':
+            if (!parseNumber(s, n, j, mindigits, maxdigits, second)) return false;
+            break;
+
+         case 'S':
+            if (!parseNumber(s, n, j, tok.count, tok.count, millisecond)) return false;
+            if (tok.count == 1)      millisecond *= 100;
+            else if (tok.count == 2) millisecond *= 10;
+            break;
 
+         case 'Z': case 'X': case 'x': {
+            if (j < n && s[j] == 'Z' && (tok.field == 'X' || (tok.field == 'Z' && tok.count == 5))) {
+               cur_offset = 0;
+               ++j;
+               break;
+            }
+            if (j >= n || (s[j] != '+' && s[j] != '-')) return false;
+            int sign = (s[j] == '-') ? -1 : 1;
+            ++j;
+            int hours, minutes = 0;
+            if (!parseNumber(s, n, j, 2, 2, hours)) return false;
+            bool colon = (tok.field == 'Z') ? (tok.count == 5) : (tok.count == 3);
+            if (colon) {
+               if (j >= n || s[j] != ':') return false;
+               ++j;
+            }
+            if (tok.field != 'Z' && tok.count == 1) {
+               if (j < n && s[j] >= '0' && s[j] <= '9') {
+                  if (!parseNumber(s, n, j, 2, 2, minutes) || minutes == 0) return false;
+               }
+            }
+            else if (!parseNumber(s, n, j, 2, 2, minutes)) return false;
+            if (hours > 23 || minutes > 59) return false;
+            cur_offset = sign*(hours*3600000 + minutes*60000);
+            break;
+         }
+      }
+   }
+   if (j != n) return false;
+
+   if (year < 1583 || year > 9999 || month < 1 || month > 12 ||
+         day < 1 || day > stri__time_days_in_month(year, month) ||
+         hour > 23 || minute > 59 || second > 59)
+      return false;
+
+   time = ((double)stri__time_days_from_civil(year, month, day)*86400000.0 +
+      (double)(hour*3600000 + minute*60000 + second*1000 + millisecond) -
+      (double)cur_offset)/1000.0;
+   return true;
+}
+
+
+/**
+ * A process-wide cache of date formatters and calendars
+ *
+ * Creating a DateFormat requires loading locale data, which
+ * is much more time-consuming than formatting or parsing a few dates.
+ * Here we keep at most STRI__DATEFORMAT_CACHE_SIZE recently used
+ * (formatter, calendar) pairs, keyed by format, locale, time zone ID,
+ * and leniency, and hand out their clones. Numeric-only patterns
+ * are also compiled to StriDateFormatFast objects, if possible.
+ *
+ * Not thread-safe: to be used from R's main thread only.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriDateFormatCache {
+   private:
+
+      struct Entry {
+         std::string format;
+         std::string locale;
+         UnicodeString tz;
+         bool lenient;
+         DateFormat* fmt;
+         Calendar* cal; // owns a time zone
+         StriDateFormatFast* fast; // may be NULL
+      };
+
+      static std::deque<Entry*> entries; // most recently used first
+
+      static void deleteEntry(Entry* e);
+
+   public:
+
+      static void get(const char* format_val, const char* locale_val,
+         TimeZone* tz_val, bool lenient_val, DateFormat*& fmt, Calendar*& cal,
+         const StriDateFormatFast*& fast);
+      static void clear();
+};
+
+
+std::deque<StriDateFormatCache::Entry*> StriDateFormatCache::entries;
+
+
+/** Delete a cache entry
+ *
+ * @param e entry
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriDateFormatCache::deleteEntry(Entry* e)
+{
+   if (e->fmt) delete e->fmt;
+   if (e->cal) delete e->cal;
+   if (e->fast) delete e->fast;
+   delete e;
+}
+
+
+/** Get a date formatter and a calendar
+ *
+ * @param format_val format string or one of the predefined style names
+ * @param locale_val locale ID
+ * @param tz_val time zone; adopted (deleted) by this function in any case
+ * @param lenient_val calendar leniency
+ * @param fmt [out] new DateFormat object, to be deleted by the caller
+ * @param cal [out] new Calendar object, to be deleted by the caller
+ * @param fast [out] compiled pattern or NULL, owned by the cache;
+ *    valid until the next call
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriDateFormatCache::get(const char* format_val, const char* locale_val,
+   TimeZone* tz_val, bool lenient_val, DateFormat*& fmt, Calendar*& cal,
+   const StriDateFormatFast*& fast)
+{
+   fmt = NULL;
+   cal = NULL;
+   fast = NULL;
+
+   UnicodeString tz_id;
+   tz_val->getID(tz_id);
+
+   Entry* e = NULL;
+   for (std::deque<Entry*>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      if ((*it)->lenient == lenient_val && (*it)->tz == tz_id &&
+            (*it)->format == format_val && (*it)->locale == locale_val) {
+         e = *it;
+         if (it != entries.begin()) {
+            entries.erase(it);
+            entries.push_front(e);
+         }
+         break;
+      }
+   }
+
+   if (e) {
+      delete tz_val;
+   }
+   else {
+      e = new Entry;
+      if (!e) { delete tz_val; throw StriException(MSG__MEM_ALLOC_ERROR); }
+      e->format = format_val;
+      e->locale = locale_val;
+      e->tz = tz_id;
+      e->lenient = lenient_val;
+      e->fmt = NULL;
+      e->cal = NULL;
+      e->fast = NULL;
+
+      UErrorCode status = U_ZERO_ERROR;
+      bool is_pattern;
+      e->fmt = stri__datetime_createformat(format_val, locale_val, is_pattern, status);
+      STRI__CHECKICUSTATUS_THROW(status, {delete tz_val; deleteEntry(e);})
+      if (!e->fmt) { delete tz_val; deleteEntry(e); throw StriException(MSG__INTERNAL_ERROR); }
+
+      status = U_ZERO_ERROR;
+      e->cal = Calendar::createInstance(locale_val, status);
+      STRI__CHECKICUSTATUS_THROW(status, {delete tz_val; deleteEntry(e);})
+
+      e->cal->adoptTimeZone(tz_val); /* The Calendar takes ownership of the TimeZone. */
+      e->cal->setLenient(lenient_val);
+
+      if (is_pattern)
+         e->fast = StriDateFormatFast::create(format_val, locale_val, e->cal);
+
+      while (entries.size() >= STRI__DATEFORMAT_CACHE_SIZE) {
+         deleteEntry(entries.back());
+         entries.pop_back();
+      }
+      entries.push_front(e);
+   }
+
+   fast = e->fast;
+   fmt = (DateFormat*)e->fmt->clone();
+   cal = e->cal->clone();
+   if (!fmt || !cal) {
+      if (fmt) { delete fmt; fmt = NULL; }
+      if (cal) { delete cal; cal = NULL; }
+      throw StriException(MSG__MEM_ALLOC_ERROR);
+   }
+
+   // fields not set by parse() are taken from the calendar;
+   // like a newly created one, it should be set to the current time
+   UErrorCode status = U_ZERO_ERROR;
+   cal->setTime(Calendar::getNow(), status);
+   STRI__CHECKICUSTATUS_THROW(status, {
+      delete fmt; fmt = NULL;
+      delete cal; cal = NULL;
+   })
+}
+
+
+/** Delete all the cached formatters
+ *
+ * Called when the library is unloaded.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriDateFormatCache::clear()
+{
+   while (!entries.empty()) {
+      deleteEntry(entries.back());
+      entries.pop_back();
+   }
+}
+
+
+/** Delete all the cached formatters (see StriDateFormatCache)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__datetime_format_clear_cache()
+{
+   StriDateFormatCache::clear();
+}
+
+
+/**
+ * Format date-time objects
+ *
+ * @param time
+ * @param format
+ * @param tz
+ * @param locale
+ *
+ * @return character vector
+ *
+ * @version 0.5-1 (Marek Gagolewski, 2015-01-05)
+ *
+ * @version 0.5-1 (Marek Gagolewski, 2015-02-22)
+ *    use tz
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriDateFormatCache
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriDateFormatFast
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriTimeZoneOffsets
+ */
+SEXP stri_datetime_format(SEXP time, SEXP format, SEXP tz, SEXP locale) {
+   PROTECT(time = stri_prepare_arg_POSIXct(time, "time"));
+   const char* locale_val = stri__prepare_arg_locale(locale, "locale", true);
+   const char* format_val = stri__prepare_arg_string_1_notNA(format, "format");
+
+   TimeZone* tz_val = stri__prepare_arg_timezone(tz, "tz", true/*allowdefault*/);
+   Calendar* cal = NULL;
+   DateFormat* fmt = NULL;
+   StriTimeZoneOffsets* offsets = NULL;
+   STRI__ERROR_HANDLER_BEGIN(1)
+   R_len_t vectorize_length = LENGTH(time);
+   StriContainerDouble time_cont(time, vectorize_length);
+
+   TimeZone* tz_adopt = tz_val;
+   tz_val = NULL; /* StriDateFormatCache takes ownership of the TimeZone. */
+   const StriDateFormatFast* fast = NULL;
+   StriDateFormatCache::get(format_val, locale_val, tz_adopt, true, fmt, cal, fast);
+
+   double from, to;
+   if (fast && !fast->isFixed() && stri__datetime_range(time_cont, from, to)) {
+      offsets = new StriTimeZoneOffsets(cal->getTimeZone(), from, to);
+      if (!offsets) throw StriException(MSG__MEM_ALLOC_ERROR);
+   }
+
+   UErrorCode status = U_ZERO_ERROR;
    SEXP ret;
    STRI__PROTECT(ret = Rf_allocVector(STRSXP, vectorize_length));
+   std::string buf; // reused
    for (R_len_t i=0; i<vectorize_length; ++i) {
       if (time_cont.isNA(i)) {
          SET_STRING_ELT(ret, i, NA_STRING);
          continue;
       }
 
+      if (fast && fast->format(time_cont.get(i), offsets, buf)) {
+         SET_STRING_ELT(ret, i, Rf_mkCharLenCE(buf.data(), (int)buf.length(), (cetype_t)CE_UTF8));
+         continue;
+      }
+
       status = U_ZERO_ERROR;
       cal->setTime((UDate)(time_cont.get(i)*1000.0), status);
       STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
@@ -153,12 +800,14 @@ SEXP stri_datetime_format(SEXP time, SEXP format, SEXP tz, SEXP locale) {
    if (tz_val) { delete tz_val; tz_val = NULL; }
    if (fmt) { delete fmt; fmt = NULL; }
    if (cal) { delete cal; cal = NULL; }
+   if (offsets) { delete offsets; offsets = NULL; }
    STRI__UNPROTECT_ALL
    return ret;
    STRI__ERROR_HANDLER_END({
       if (tz_val) { delete tz_val; tz_val = NULL; }
       if (fmt) { delete fmt; fmt = NULL; }
       if (cal) { delete cal; cal = NULL; }
+      if (offsets) { delete offsets; offsets = NULL; }
    })
 }
 
@@ -178,6 +827,8 @@ SEXP stri_datetime_format(SEXP time, SEXP format, SEXP tz, SEXP locale) {
  * @version 0.5-1 (Marek Gagolewski, 2015-01-11) lenient arg added
  * @version 0.5-1 (Marek Gagolewski, 2015-02-22) use tz
  * @version 0.5-1 (Marek Gagolewski, 2015-03-01) set tzone attrib on retval
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) use StriDateFormatCache
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19) use StriDateFormatFast
  */
 SEXP stri_datetime_parse(SEXP str, SEXP format, SEXP lenient, SEXP tz, SEXP locale) {
    PROTECT(str = stri_prepare_arg_string(str, "str"));
@@ -187,75 +838,24 @@ SEXP stri_datetime_parse(SEXP str, SEXP format, SEXP lenient, SEXP tz, SEXP loca
    if (!isNull(tz)) PROTECT(tz = stri_prepare_arg_string_1(tz, "tz"));
    else             PROTECT(tz); /* needed to set tzone attrib */
 
-   // "format" may be one of:
-   const char* format_opts[] = {
-      "date_full", "date_long", "date_medium", "date_short",
-      "date_relative_full", "date_relative_long", "date_relative_medium", "date_relative_short",
-      "time_full", "time_long", "time_medium", "time_short",
-      "time_relative_full", "time_relative_long", "time_relative_medium", "time_relative_short",
-      "datetime_full", "datetime_long", "datetime_medium", "datetime_short",
-      "datetime_relative_full", "datetime_relative_long", "datetime_relative_medium", "datetime_relative_short",
-      NULL};
-   int format_cur = stri__match_arg(format_val, format_opts);
-
    TimeZone* tz_val = stri__prepare_arg_timezone(tz, "tz", true/*allowdefault*/);
    Calendar* cal = NULL;
    DateFormat* fmt = NULL;
    STRI__ERROR_HANDLER_BEGIN(2)
    R_len_t vectorize_length = LENGTH(str);
    StriContainerUTF16 str_cont(str, vectorize_length);
-   UnicodeString format_str(format_val);
-
-   UErrorCode status = U_ZERO_ERROR;
-   if (format_cur >= 0) {
-      DateFormat::EStyle style = DateFormat::kNone;
-      switch (format_cur % 8) {
-         case 0:  style = DateFormat::kFull; break;
-         case 1:  style = DateFormat::kLong; break;
-         case 2:  style = DateFormat::kMedium; break;
-         case 3:  style = DateFormat::kShort; break;
-         case 4:  style = DateFormat::kFullRelative; break;
-         case 5:  style = DateFormat::kLongRelative; break;
-         case 6:  style = DateFormat::kMediumRelative; break;
-         case 7:  style = DateFormat::kShortRelative; break;
-         default: style = DateFormat::kNone; break;
-      }
-
-      /* ICU 54.1: Relative time styles are not currently supported.  */
-      switch (format_cur / 8) {
-         case 0:
-            fmt = DateFormat::createDateInstance(style, Locale::createFromName(locale_val));
-            break;
-
-         case 1:
-            fmt = DateFormat::createTimeInstance((DateFormat::EStyle)(style & ~DateFormat::kRelative),
-               Locale::createFromName(locale_val));
-            break;
-
-         case 2:
-            fmt = DateFormat::createDateTimeInstance(style,
-               (DateFormat::EStyle)(style & ~DateFormat::kRelative),
-               Locale::createFromName(locale_val));
-            break;
 
-         default:
-            fmt = NULL;
-            break;
+   TimeZone* tz_adopt = tz_val;
+   tz_val = NULL; /* StriDateFormatCache takes ownership of the TimeZone. */
+   const StriDateFormatFast* fast = NULL;
+   StriDateFormatCache::get(format_val, locale_val, tz_adopt, lenient_val, fmt, cal, fast);
 
-      }
+   UErrorCode status = U_ZERO_ERROR;
+   int millisecond = 0; // not changed by parse() if not in the pattern
+   if (fast) {
+      millisecond = cal->get(UCAL_MILLISECOND, status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
    }
-   else
-      fmt = new SimpleDateFormat(format_str, Locale::createFromName(locale_val), status);
-   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-
-   status = U_ZERO_ERROR;
-   cal = Calendar::createInstance(locale_val, status);
-   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
-
-   cal->adoptTimeZone(tz_val);
-   tz_val = NULL; /* The Calendar takes ownership of the TimeZone. */
-
-   cal->setLenient(lenient_val);
 
    SEXP ret;
    STRI__PROTECT(ret = Rf_allocVector(REALSXP, vectorize_length));
@@ -265,6 +865,11 @@ SEXP stri_datetime_parse(SEXP str, SEXP format, SEXP lenient, SEXP tz, SEXP loca
          continue;
       }
 
+      SEXP curs = STRING_ELT(str, i);
+      if (fast && IS_ASCII(curs) &&
+            fast->parse(CHAR(curs), LENGTH(curs), millisecond, REAL(ret)[i]))
+         continue;
+
       status = U_ZERO_ERROR;
       ParsePosition pos;
       fmt->parse(str_cont.get(i), *cal, pos);
@@ -32,8 +32,13 @@
 
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
+#include "stri_time_civil.h"
 #include <unicode/strenum.h>
+#include <unicode/basictz.h>
+#include <unicode/tztrans.h>
+#include <unicode/tzrule.h>
 #include <string>
+#include <algorithm>
 
 
 /** List available time zone IDs
@@ -236,3 +241,73 @@ SEXP stri_timezone_info(SEXP tz, SEXP locale, SEXP display_type) {
    UNPROTECT(1);
    return vals;
 }
+
+
+/** Determine the transitions of a time zone over a given time range
+ *
+ * @param tz time zone
+ * @param from start of the range, in milliseconds since the epoch
+ * @param to end of the range
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+StriTimeZoneOffsets::StriTimeZoneOffsets(const TimeZone& tz, double from, double to)
+{
+   this->from = from;
+   this->to = to;
+   this->first_offset = 0;
+   this->valid = false;
+
+   const BasicTimeZone* btz = dynamic_cast<const BasicTimeZone*>(&tz);
+   if (!btz || !(from <= to)) return;
+
+   UErrorCode status = U_ZERO_ERROR;
+   int32_t raw_offset, dst_offset;
+   tz.getOffset(from, false, raw_offset, dst_offset, status);
+   if (U_FAILURE(status)) return;
+   first_offset = raw_offset + dst_offset;
+
+   TimeZoneTransition trans;
+   UDate base = from;
+   while (btz->getNextTransition(base, false, trans) && trans.getTime() <= to) {
+      const TimeZoneRule* rule = trans.getTo();
+      if (!rule) return;
+      trans_time.push_back(trans.getTime());
+      trans_offset.push_back(rule->getRawOffset() + rule->getDSTSavings());
+      base = trans.getTime();
+   }
+
+   valid = true;
+}
+
+
+/** Get the UTC offset in effect at a given time
+ *
+ * @param t time in milliseconds since the epoch; must be covered
+ * @return offset in milliseconds, including the daylight savings
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+int StriTimeZoneOffsets::getOffset(double t) const
+{
+   size_t k = std::upper_bound(trans_time.begin(), trans_time.end(), t) - trans_time.begin();
+   return (k == 0) ? first_offset : trans_offset[k-1];
+}
+
+
+/** Are there any transitions in a given time range?
+ *
+ * @param t1 start of the range, in milliseconds since the epoch
+ * @param t2 end of the range
+ * @return true if there is a transition in [t1, t2] or if
+ *    the range is not covered
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+bool StriTimeZoneOffsets::hasTransitions(double t1, double t2) const
+{
+   if (!covers(t1) || !covers(t2)) return true;
+   std::vector<double>::const_iterator it =
+      std::lower_bound(trans_time.begin(), trans_time.end(), t1);
+   return (it != trans_time.end() && *it <= t2);
+}
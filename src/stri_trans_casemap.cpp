@@ -166,12 +166,17 @@ SEXP stri_trans_totitle(SEXP str, SEXP opts_brkiter) {
  *
  * @version 0.6-1 (Marek Gagolewski, 2015-07-11)
  *    now this is an internal function
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
 */
 SEXP stri_trans_casemap(SEXP str, int _type, SEXP locale)
 {
    if (_type < 1 || _type > 2) Rf_error(MSG__INCORRECT_INTERNAL_ARG);
    const char* qloc = stri__prepare_arg_locale(locale, "locale", true); /* this is R_alloc'ed */
    PROTECT(str = stri_prepare_arg_string(str, "str")); // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_trans_casemap(str_unique, _type, locale))
 
 // version 0.2-1 - Does not work with ICU 4.8 (but we require ICU >= 50)
    UCaseMap* ucasemap = NULL;
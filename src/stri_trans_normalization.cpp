@@ -32,6 +32,7 @@
 #include "stri_stringi.h"
 #include "stri_container_utf16.h"
 #include <unicode/normalizer2.h>
+#include <string>
 
 
 #define STRI_UNINORM_NFC 10
@@ -40,6 +41,52 @@
 #define STRI_UNINORM_NFKD 21
 #define STRI_UNINORM_NFKC_CF 12
 
+
+/** Is a CHARSXP surely in a given normal form (without converting it to UTF-16)?
+ *
+ * ASCII strings are in NFC, NFD, NFKC, and NFKD, but not in NFKC_Casefold.
+ * As of ICU 60, valid UTF-8 strings are checked with isNormalizedUTF8.
+ *
+ * @param curs non-NA CHARSXP
+ * @param normalizer normalizer
+ * @param type normalization type
+ * @return true if curs is in the normal form and is in ASCII or UTF-8;
+ *    false if it is not or we do not know
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+static bool stri__normalizer_isnormalized_charsxp(SEXP curs,
+   const Normalizer2* normalizer, int type)
+{
+   if (IS_ASCII(curs))
+      return (type != STRI_UNINORM_NFKC_CF);
+
+#if U_ICU_VERSION_MAJOR_NUM >= 60
+   if (IS_UTF8(curs)) {
+      const char* s = CHAR(curs);
+      R_len_t n = LENGTH(curs);
+
+      // invalid byte sequences would be replaced with U+FFFD in UTF-16
+      R_len_t j = 0;
+      UChar32 c;
+      while (j < n) {
+         U8_NEXT(s, j, n, c);
+         if (c < 0) return false;
+      }
+
+      UErrorCode status = U_ZERO_ERROR;
+      bool ret = normalizer->isNormalizedUTF8(StringPiece(s, n), status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      return ret;
+   }
+#else
+   (void)normalizer; // unused
+#endif
+
+   return false;
+}
+
+
 /** Get Desired Normalizer2 instance
  *
  * @param type R object, will be tested whether it's an integer vector of length 1
@@ -117,6 +164,13 @@ const Normalizer2* stri__normalizer_get(int _type)
  *
  * @version 0.6-1 (Marek Gagolewski, 2015-07-11)
  *    This is now an internal function
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    return the original CHARSXP if it is already normalized;
+ *    normalize only the part after spanQuickCheckYes
  */
 SEXP stri_trans_nf(SEXP str, int type)
 {
@@ -133,21 +187,52 @@ SEXP stri_trans_nf(SEXP str, int type)
       stri__normalizer_get(type); // auto `type` check here, call before ERROR_HANDLER
 
    PROTECT(str = stri_prepare_arg_string(str, "str"));    // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_trans_nf(str_unique, type))
    R_len_t str_length = LENGTH(str);
 
    STRI__ERROR_HANDLER_BEGIN(1)
-   StriContainerUTF16 str_cont(str, str_length, false); // writable, no recycle
+   StriContainerUTF16 str_cont(str, str_length); // read-only, converted lazily
+
+   SEXP ret;
+   STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_length));
 
    for (R_len_t i=0; i<str_length; ++i) {
-      if (str_cont.isNA(i)) continue;
+      SEXP curs = STRING_ELT(str, i);
+      if (curs == NA_STRING) {
+         SET_STRING_ELT(ret, i, NA_STRING);
+         continue;
+      }
+
+      if (stri__normalizer_isnormalized_charsxp(curs, normalizer, type)) {
+         SET_STRING_ELT(ret, i, curs); // most often the case
+         continue;
+      }
+
+      const UnicodeString& cur = str_cont.get(i);
       UErrorCode status = U_ZERO_ERROR;
-      str_cont.set(i, normalizer->normalize(str_cont.get(i), status));
+      int32_t span = normalizer->spanQuickCheckYes(cur, status);
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+      if (span == cur.length() && (IS_UTF8(curs) || IS_ASCII(curs))
+            && cur.indexOf((UChar)0xFFFD) < 0 /* a valid UTF-8 string */) {
+         SET_STRING_ELT(ret, i, curs);
+         continue;
+      }
+
+      // normalize the unnormalized suffix only
+      UnicodeString out(cur, 0, span);
+      normalizer->normalizeSecondAndAppend(out, cur.tempSubString(span), status);
       STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+
+      std::string s;
+      out.toUTF8String(s);
+      SET_STRING_ELT(ret, i, Rf_mkCharLenCE(s.c_str(), (int)s.length(), CE_UTF8));
    }
 
    // normalizer shall not be deleted at all
    STRI__UNPROTECT_ALL
-   return str_cont.toR();
+   return ret;
    STRI__ERROR_HANDLER_END(;/* nothing special to be done on error */)
 }
 
@@ -173,6 +258,12 @@ SEXP stri_trans_nf(SEXP str, int type)
  *
  * @version 0.6-1 (Marek Gagolewski, 2015-07-11)
  *    This is now an internal function
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    do not convert ASCII (and, as of ICU 60, UTF-8) strings to UTF-16
  */
 SEXP stri_trans_isnf(SEXP str, int type)
 {
@@ -180,6 +271,8 @@ SEXP stri_trans_isnf(SEXP str, int type)
       stri__normalizer_get(type); // auto `type` check here, call before ERROR_HANDLER
 
    PROTECT(str = stri_prepare_arg_string(str, "str"));    // prepare string argument
+   STRI__UNIQUE_DISPATCH(str, str_unique, 1, false,
+      stri_trans_isnf(str_unique, type))
    R_len_t str_length = LENGTH(str);
 
    STRI__ERROR_HANDLER_BEGIN(1)
@@ -198,6 +291,11 @@ SEXP stri_trans_isnf(SEXP str, int type)
          continue;
       }
 
+      if (stri__normalizer_isnormalized_charsxp(STRING_ELT(str, i), normalizer, type)) {
+         ret_tab[i] = TRUE;
+         continue;
+      }
+
       // C API will not be faster here
       // as it is a simple wrapper for C++ API
 
@@ -33,25 +33,58 @@
 #include "stri_stringi.h"
 #include "stri_container_utf8.h"
 #include "stri_string8buf.h"
-#include <deque>
+#include <vector>
 
 
 /**
- * fill a deque with CHARSXPs == individual code points in s of length n
+ * A code point translation table for stri_trans_char
+ *
+ * ASCII code points are looked up directly, the other ones
+ * in a two-level table (rows of 256 code points are allocated
+ * only for the blocks that include a translated code point).
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
  */
-void stri__split_codepoints(deque<SEXP>& out, const char* s, int n) {
-   UChar32 c = 0;
-   R_len_t j = 0; // current pos
-   R_len_t i = 0; // last pos
-   while (j < n) {
-      U8_NEXT(s, j, n, c);
-      out.push_back(Rf_mkCharLenCE(s+i, j-i, CE_UTF8));
-
-      if (c < 0)
-         Rf_warning(MSG__INVALID_UTF8);
-      i = j;
-   }
-}
+class StriTransCharTable {
+
+   private:
+
+      UChar32 m_ascii[128];       // -1 if not translated
+      std::vector<int> m_block;   // row index for each block, -1 if none
+      std::vector<UChar32> m_rows;
+
+   public:
+
+      StriTransCharTable() :
+         m_block(0x110000>>8, -1)
+      {
+         for (int c = 0; c < 128; ++c)
+            m_ascii[c] = -1;
+      }
+
+      /** Translate c to r (overwrites the previous setting) */
+      void set(UChar32 c, UChar32 r)
+      {
+         if (c < 128) {
+            m_ascii[c] = r;
+            return;
+         }
+         if (m_block[c>>8] < 0) {
+            m_block[c>>8] = (int)(m_rows.size()>>8);
+            m_rows.resize(m_rows.size()+256, -1);
+         }
+         m_rows[((size_t)m_block[c>>8]<<8) | (c&0xFF)] = r;
+      }
+
+      /** @return translated code point or -1 */
+      inline UChar32 get(UChar32 c) const
+      {
+         if (c < 128)
+            return m_ascii[c];
+         int b = m_block[c>>8];
+         return (b < 0) ? -1 : m_rows[((size_t)b<<8) | (c&0xFF)];
+      }
+};
 
 
 /**
@@ -65,7 +98,9 @@ void stri__split_codepoints(deque<SEXP>& out, const char* s, int n) {
  *
  * @version 0.5-1 (Marek Gagolewski, 2015-04-06)
  *
- *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    single pass over each string using StriTransCharTable
+ *    (used to call stri_replace_all_fixed for each code point)
  */
 SEXP stri_trans_char(SEXP str, SEXP pattern, SEXP replacement) {
    PROTECT(str          = stri_prepare_arg_string(str, "str"));
@@ -81,17 +116,30 @@ SEXP stri_trans_char(SEXP str, SEXP pattern, SEXP replacement) {
       return stri__vector_NA_strings(LENGTH(str));
    }
 
-   const String8* s_pat = &pattern_cont.get(0);
-   const String8* s_rep = &replacement_cont.get(0);
-
-   deque<SEXP> d_pat;
-   stri__split_codepoints(d_pat, s_pat->c_str(), s_pat->length());
-
-   deque<SEXP> d_rep;
-   stri__split_codepoints(d_rep, s_rep->c_str(), s_rep->length());
+   const char* pat_s = pattern_cont.get(0).c_str();
+   R_len_t pat_n = pattern_cont.get(0).length();
+   const char* rep_s = replacement_cont.get(0).c_str();
+   R_len_t rep_n = replacement_cont.get(0).length();
+
+   // later settings override the earlier ones
+   StriTransCharTable table;
+   R_len_t m = 0;
+   R_len_t maxgrow = 0; // max. increase in the number of bytes per code point
+   R_len_t jp = 0, jr = 0;
+   while (jp < pat_n && jr < rep_n) {
+      UChar32 cp, cr;
+      U8_NEXT(pat_s, jp, pat_n, cp);
+      U8_NEXT(rep_s, jr, rep_n, cr);
+      if (cp < 0 || cr < 0)
+         Rf_warning(MSG__INVALID_UTF8);
+      else {
+         table.set(cp, cr);
+         maxgrow = std::max(maxgrow, (R_len_t)(U8_LENGTH(cr)-U8_LENGTH(cp)));
+      }
+      ++m;
+   }
 
-   R_len_t m = std::min(d_rep.size(), d_pat.size());
-   if (d_pat.size() != d_rep.size()) {
+   if (jp < pat_n || jr < rep_n) {
       Rf_warning(MSG__WARN_RECYCLING_RULE);
    }
 
@@ -101,24 +149,41 @@ SEXP stri_trans_char(SEXP str, SEXP pattern, SEXP replacement) {
       return str_cont.toR(); // assure UTF-8
    }
 
-
-   SEXP new_pattern;
-   SEXP new_replacement;
-   STRI__PROTECT(new_pattern = Rf_allocVector(STRSXP, m));
-   STRI__PROTECT(new_replacement = Rf_allocVector(STRSXP, m));
-   deque<SEXP>::iterator it1 = d_pat.begin();
-   deque<SEXP>::iterator it2 = d_rep.begin();
-   for (R_len_t i=0; i<m; ++i) {
-      SET_STRING_ELT(new_pattern,     i, *it1++);
-      SET_STRING_ELT(new_replacement, i, *it2++);
-   }
-
+   R_len_t str_length = LENGTH(str);
+   StriContainerUTF8 str_cont(str, str_length);
 
    SEXP ret;
-   STRI__PROTECT(ret = stri_replace_all_fixed(str, new_pattern, new_replacement,
-      /*vectorize_all*/Rf_ScalarLogical(FALSE), /*opts_fixed*/R_NilValue)
-   )
-
+   STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_length));
+
+   String8buf buf(0);
+   for (R_len_t i = 0; i < str_length; ++i) {
+      if (str_cont.isNA(i)) {
+         SET_STRING_ELT(ret, i, NA_STRING);
+         continue;
+      }
+
+      const char* str_cur_s = str_cont.get(i).c_str();
+      R_len_t str_cur_n = str_cont.get(i).length();
+      if ((double)str_cur_n*(1+maxgrow) > (double)INT_MAX)
+         throw StriException(MSG__MEM_ALLOC_ERROR);
+      buf.resize(str_cur_n*(1+maxgrow), false);
+      char* out = buf.data();
+      R_len_t k = 0;
+      for (R_len_t j = 0; j < str_cur_n; ) {
+         R_len_t jlast = j;
+         UChar32 c;
+         U8_NEXT(str_cur_s, j, str_cur_n, c);
+         UChar32 r = (c < 0) ? -1 : table.get(c);
+         if (r < 0) { // copy as-is
+            while (jlast < j)
+               out[k++] = str_cur_s[jlast++];
+         }
+         else
+            U8_APPEND_UNSAFE(out, k, r);
+      }
+
+      SET_STRING_ELT(ret, i, Rf_mkCharLenCE(out, k, CE_UTF8));
+   }
 
    STRI__UNPROTECT_ALL
    return ret;
@@ -34,7 +34,122 @@
 #include "stri_container_utf16.h"
 #include <unicode/translit.h>
 #include <unicode/strenum.h>
+#include <unicode/normalizer2.h>
 #include <string>
+#include <deque>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/** maximal number of transliterators kept in StriTransliteratorCache */
+#define STRI__TRANSLITERATOR_CACHE_SIZE 16
+
+/** chunk size for the multithreaded stri_trans_general */
+#define STRI__TRANS_GENERAL_CHUNK_SIZE 256
+
+
+/**
+ * A process-wide cache of transliterators
+ *
+ * Building a transliterator (in particular, a compound one)
+ * requires parsing its ID and rules. Here we keep at most
+ * STRI__TRANSLITERATOR_CACHE_SIZE recently used ones,
+ * keyed by ID and direction.
+ *
+ * Not thread-safe: to be used from R's main thread only.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+class StriTransliteratorCache {
+   private:
+
+      struct Entry {
+         UnicodeString id;
+         UTransDirection dir;
+         Transliterator* trans;
+      };
+
+      static std::deque<Entry*> entries; // most recently used first
+
+   public:
+
+      static const Transliterator* get(const UnicodeString& id, UTransDirection dir);
+      static void clear();
+};
+
+
+std::deque<StriTransliteratorCache::Entry*> StriTransliteratorCache::entries;
+
+
+/** Get a transliterator
+ *
+ * @param id transform ID
+ * @param dir direction
+ * @return transliterator, owned by the cache; valid until the next call
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+const Transliterator* StriTransliteratorCache::get(const UnicodeString& id, UTransDirection dir)
+{
+   for (std::deque<Entry*>::iterator it = entries.begin(); it != entries.end(); ++it) {
+      Entry* e = *it;
+      if (e->dir == dir && e->id == id) {
+         if (it != entries.begin()) {
+            entries.erase(it);
+            entries.push_front(e);
+         }
+         return e->trans;
+      }
+   }
+
+   UErrorCode status = U_ZERO_ERROR;
+   Transliterator* trans = Transliterator::createInstance(id, dir, status);
+   STRI__CHECKICUSTATUS_THROW(status, {if (trans) delete trans;})
+
+   while (entries.size() >= STRI__TRANSLITERATOR_CACHE_SIZE) {
+      Entry* e = entries.back();
+      entries.pop_back();
+      delete e->trans;
+      delete e;
+   }
+
+   Entry* e = new Entry;
+   if (!e) { delete trans; throw StriException(MSG__MEM_ALLOC_ERROR); }
+   e->id = id;
+   e->dir = dir;
+   e->trans = trans;
+   entries.push_front(e);
+   return trans;
+}
+
+
+/** Delete all the cached transliterators
+ *
+ * Called when the library is unloaded.
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void StriTransliteratorCache::clear()
+{
+   while (!entries.empty()) {
+      Entry* e = entries.back();
+      entries.pop_back();
+      delete e->trans;
+      delete e;
+   }
+}
+
+
+/** Delete all the cached transliterators (see StriTransliteratorCache)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__trans_general_clear_cache()
+{
+   StriTransliteratorCache::clear();
+}
 
 
 /** List available transliterators
@@ -90,17 +205,31 @@ SEXP stri_trans_list()
  *
  * @param str character vector
  * @param id single string
+ * @param nthreads single integer, number of threads to use
  * @return character vector
  *
  * @version 0.2-2 (Marek Gagolewski, 2014-04-19)
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    STRI__UNIQUE_DISPATCH
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    use StriTransliteratorCache; new arg: nthreads
  */
-SEXP stri_trans_general(SEXP str, SEXP id)
+SEXP stri_trans_general(SEXP str, SEXP id, SEXP nthreads)
 {
    PROTECT(str = stri_prepare_arg_string(str, "str"));
    PROTECT(id  = stri_prepare_arg_string_1(id, "id"));
+   int nthreads_val = stri__prepare_arg_integer_1_notNA(nthreads, "nthreads");
+   if (nthreads_val < 1) {
+      UNPROTECT(2);
+      Rf_error(MSG__EXPECTED_POSITIVE, "nthreads");
+   }
+   STRI__UNIQUE_DISPATCH(str, str_unique, 2, false,
+      stri_trans_general(str_unique, id, nthreads))
    R_len_t str_length = LENGTH(str);
 
-   Transliterator* trans = NULL;
+   std::vector<Transliterator*> trans_clones; // one per thread
    STRI__ERROR_HANDLER_BEGIN(2)
    StriContainerUTF16  id_cont(id, 1);
    if (id_cont.isNA(0)) {
@@ -108,21 +237,271 @@ SEXP stri_trans_general(SEXP str, SEXP id)
       return stri__vector_NA_strings(str_length);
    }
 
-   UErrorCode status = U_ZERO_ERROR;
-   trans = Transliterator::createInstance(id_cont.get(0), UTRANS_FORWARD, status);
-   STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+   const Transliterator* trans = StriTransliteratorCache::get(id_cont.get(0), UTRANS_FORWARD);
 
    StriContainerUTF16 str_cont(str, str_length, false); // writable, no recycle
 
-   for (R_len_t i=0; i<str_length; ++i) {
-      if (str_cont.isNA(i)) continue;
-      trans->transliterate(str_cont.getWritable(i));
+#ifdef _OPENMP
+   if (nthreads_val > str_length/STRI__TRANS_GENERAL_CHUNK_SIZE)
+      nthreads_val = str_length/STRI__TRANS_GENERAL_CHUNK_SIZE;
+
+   if (nthreads_val > 1) {
+      // a transliterator may not be used by many threads at a time
+      for (int t=0; t<nthreads_val; ++t) {
+         Transliterator* cur = trans->clone();
+         if (!cur) throw StriException(MSG__MEM_ALLOC_ERROR);
+         trans_clones.push_back(cur);
+      }
+
+      // no R API calls below
+      #pragma omp parallel for num_threads(nthreads_val) schedule(dynamic, STRI__TRANS_GENERAL_CHUNK_SIZE)
+      for (R_len_t i=0; i<str_length; ++i) {
+         if (str_cont.isNA(i)) continue;
+         trans_clones[omp_get_thread_num()]->transliterate(str_cont.getWritable(i));
+      }
+
+      for (size_t t=0; t<trans_clones.size(); ++t)
+         delete trans_clones[t];
+      trans_clones.clear();
+   }
+   else
+#endif
+   {
+      for (R_len_t i=0; i<str_length; ++i) {
+         if (str_cont.isNA(i)) continue;
+         trans->transliterate(str_cont.getWritable(i));
+      }
    }
 
-   if (trans) { delete trans; trans = NULL; }
    STRI__UNPROTECT_ALL
    return str_cont.toR();
    STRI__ERROR_HANDLER_END(
-      if (trans) { delete trans; trans = NULL; }
+      for (size_t t=0; t<trans_clones.size(); ++t)
+         delete trans_clones[t];
+      trans_clones.clear();
+   )
+}
+
+
+/** Text cleaning operations supported by stri_trans_pipeline;
+ *  any other step is a transform ID
+ */
+#define STRI__PIPELINE_TRIM_BOTH     1
+#define STRI__PIPELINE_TRIM_LEFT     2
+#define STRI__PIPELINE_TRIM_RIGHT    3
+#define STRI__PIPELINE_SQUISH        4
+#define STRI__PIPELINE_NORMALIZE     5
+#define STRI__PIPELINE_TRANSLITERATE 6
+
+
+/** A single step of stri_trans_pipeline
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+struct StriPipelineStep {
+   int type;
+   const Normalizer2* normalizer; // not owned
+   Transliterator* trans;         // owned
+};
+
+
+/** Apply a single pipeline step to a string
+ *
+ * @param step step
+ * @param cur [in/out] string to process; may be swapped with tmp
+ * @param tmp [in/out] auxiliary buffer
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+void stri__trans_pipeline_apply(const StriPipelineStep& step,
+   UnicodeString*& cur, UnicodeString*& tmp)
+{
+   switch (step.type) {
+      case STRI__PIPELINE_TRIM_BOTH:
+      case STRI__PIPELINE_TRIM_LEFT:
+      case STRI__PIPELINE_TRIM_RIGHT: {
+         const UChar* s = cur->getBuffer();
+         R_len_t n = cur->length();
+         R_len_t start = 0, end = n;
+         UChar32 c;
+         if (step.type != STRI__PIPELINE_TRIM_RIGHT) {
+            while (start < n) {
+               R_len_t j = start;
+               U16_NEXT(s, j, n, c);
+               if (!u_isUWhiteSpace(c)) break;
+               start = j;
+            }
+         }
+         if (step.type != STRI__PIPELINE_TRIM_LEFT) {
+            while (end > start) {
+               R_len_t j = end;
+               U16_PREV(s, start, j, c);
+               if (!u_isUWhiteSpace(c)) break;
+               end = j;
+            }
+         }
+         if (end < n)   cur->truncate(end);
+         if (start > 0) cur->remove(0, start);
+         break;
+      }
+
+      case STRI__PIPELINE_SQUISH: {
+         // each whitespace run -> single space; most strings need no change
+         const UChar* s = cur->getBuffer();
+         R_len_t n = cur->length();
+         R_len_t j = 0;
+         bool change = false, prev_ws = false;
+         UChar32 c;
+         while (!change && j < n) {
+            U16_NEXT(s, j, n, c);
+            bool ws = u_isUWhiteSpace(c);
+            change = ws && (prev_ws || c != (UChar32)' ');
+            prev_ws = ws;
+         }
+         if (!change) break;
+
+         tmp->remove();
+         prev_ws = false;
+         j = 0;
+         while (j < n) {
+            U16_NEXT(s, j, n, c);
+            bool ws = u_isUWhiteSpace(c);
+            if (!ws) tmp->append(c);
+            else if (!prev_ws) tmp->append((UChar)0x20);
+            prev_ws = ws;
+         }
+         std::swap(cur, tmp);
+         break;
+      }
+
+      case STRI__PIPELINE_NORMALIZE: {
+         // normalize only what follows the longest normalized prefix
+         UErrorCode status = U_ZERO_ERROR;
+         int32_t span = step.normalizer->spanQuickCheckYes(*cur, status);
+         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+         if (span == cur->length()) break;
+
+         tmp->setTo(*cur, 0, span);
+         step.normalizer->normalizeSecondAndAppend(*tmp, cur->tempSubString(span), status);
+         STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+         std::swap(cur, tmp);
+         break;
+      }
+
+      case STRI__PIPELINE_TRANSLITERATE:
+         step.trans->transliterate(*cur);
+         break;
+
+      default:
+         throw StriException(MSG__INCORRECT_INTERNAL_ARG);
+   }
+}
+
+
+/** Apply a sequence of text cleaning operations
+ *
+ * Each string is converted to UTF-16 and back only once,
+ * and no intermediate character vectors are created.
+ *
+ * @param str character vector
+ * @param steps character vector, see the R manual
+ * @return character vector
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ */
+SEXP stri_trans_pipeline(SEXP str, SEXP steps)
+{
+   PROTECT(str = stri_prepare_arg_string(str, "str"));
+   PROTECT(steps = stri_prepare_arg_string(steps, "steps"));
+   STRI__UNIQUE_DISPATCH(str, str_unique, 2, false,
+      stri_trans_pipeline(str_unique, steps))
+   R_len_t str_length = LENGTH(str);
+   R_len_t steps_length = LENGTH(steps);
+
+   std::vector<StriPipelineStep> pipeline;
+   STRI__ERROR_HANDLER_BEGIN(2)
+
+   for (R_len_t k=0; k<steps_length; ++k) {
+      SEXP cur_step = STRING_ELT(steps, k);
+      if (cur_step == NA_STRING)
+         throw StriException(MSG__ARG_EXPECTED_NOT_NA, "steps");
+      const char* name = CHAR(cur_step);
+
+      StriPipelineStep step;
+      step.normalizer = NULL;
+      step.trans = NULL;
+      UErrorCode status = U_ZERO_ERROR;
+      if (!strcmp(name, "trim"))
+         step.type = STRI__PIPELINE_TRIM_BOTH;
+      else if (!strcmp(name, "trim_left"))
+         step.type = STRI__PIPELINE_TRIM_LEFT;
+      else if (!strcmp(name, "trim_right"))
+         step.type = STRI__PIPELINE_TRIM_RIGHT;
+      else if (!strcmp(name, "squish"))
+         step.type = STRI__PIPELINE_SQUISH;
+      else if (!strcmp(name, "nfc")) {
+         step.type = STRI__PIPELINE_NORMALIZE;
+         step.normalizer = Normalizer2::getNFCInstance(status);
+      }
+      else if (!strcmp(name, "nfd")) {
+         step.type = STRI__PIPELINE_NORMALIZE;
+         step.normalizer = Normalizer2::getNFDInstance(status);
+      }
+      else if (!strcmp(name, "nfkc")) {
+         step.type = STRI__PIPELINE_NORMALIZE;
+         step.normalizer = Normalizer2::getNFKCInstance(status);
+      }
+      else if (!strcmp(name, "nfkd")) {
+         step.type = STRI__PIPELINE_NORMALIZE;
+         step.normalizer = Normalizer2::getNFKDInstance(status);
+      }
+      else if (!strcmp(name, "nfkc_casefold")) {
+         step.type = STRI__PIPELINE_NORMALIZE;
+         step.normalizer = Normalizer2::getNFKCCasefoldInstance(status);
+      }
+      else {
+         // the cached instance may be evicted by the next get(), hence a clone
+         step.type = STRI__PIPELINE_TRANSLITERATE;
+         step.trans = StriTransliteratorCache::get(
+            UnicodeString::fromUTF8(name), UTRANS_FORWARD)->clone();
+         if (!step.trans) throw StriException(MSG__MEM_ALLOC_ERROR);
+      }
+      STRI__CHECKICUSTATUS_THROW(status, {/* do nothing special on err */})
+      pipeline.push_back(step);
+   }
+
+   StriContainerUTF16 str_cont(str, str_length);
+
+   SEXP ret;
+   STRI__PROTECT(ret = Rf_allocVector(STRSXP, str_length));
+
+   UnicodeString buf1, buf2; // reused
+   std::string out;          // reused
+   for (R_len_t i=0; i<str_length; ++i) {
+      if (str_cont.isNA(i)) {
+         SET_STRING_ELT(ret, i, NA_STRING);
+         continue;
+      }
+
+      UnicodeString* cur = &buf1;
+      UnicodeString* tmp = &buf2;
+      *cur = str_cont.get(i);
+      for (size_t k=0; k<pipeline.size(); ++k)
+         stri__trans_pipeline_apply(pipeline[k], cur, tmp);
+
+      out.clear();
+      cur->toUTF8String(out);
+      SET_STRING_ELT(ret, i, Rf_mkCharLenCE(out.data(), (int)out.size(), CE_UTF8));
+   }
+
+   for (size_t k=0; k<pipeline.size(); ++k)
+      if (pipeline[k].trans) delete pipeline[k].trans;
+   pipeline.clear();
+   STRI__UNPROTECT_ALL
+   return ret;
+   STRI__ERROR_HANDLER_END(
+      for (size_t k=0; k<pipeline.size(); ++k)
+         if (pipeline[k].trans) delete pipeline[k].trans;
+      pipeline.clear();
    )
 }
@@ -98,6 +98,10 @@ void stri__wrap_greedy(std::deque<R_len_t>& wrap_after,
  * @version 0.4-1 (Marek Gagolewski, 2014-12-06)
  *    new args: add_para_1, add_para_n,
  *    cost of the last line is zero
+ *
+ * @version 1.2.3 (Marek Gagolewski, 2026-10-19)
+ *    O(nwords) memory: costs computed on the fly,
+ *    only the last break position is stored for each j
  */
 void stri__wrap_dynamic(std::deque<R_len_t>& wrap_after,
    R_len_t nwords, int width_val, double exponent_val,
@@ -105,83 +109,53 @@ void stri__wrap_dynamic(std::deque<R_len_t>& wrap_after,
    const std::vector<R_len_t>& widths_trim,
    int add_para_1, int add_para_n)
 {
-#define IDX(i,j) (i)*nwords+(j)
-   vector<double> cost(nwords*nwords);
-   // where cost[IDX(i,j)] == cost of printing words i..j in a single line, i<=j
+   // sum_orig[k] == widths_orig[0] + ... + widths_orig[k-1]
+   std::vector<double> sum_orig(nwords+1, 0.0);
+   for (R_len_t k=0; k<nwords; ++k)
+      sum_orig[k+1] = sum_orig[k] + widths_orig[k];
 
-   // calculate costs:
    // there is some "punishment" for leaving blanks at the end of each line
-   // (number of "blank" codepoints ^ exponent_val)
-   for (int i=0; i<nwords; i++) {
-      int sum = 0;
-      for (int j=i; j<nwords; j++) {
-         if (j > i) {
-            if (cost[IDX(i,j-1)] < 0.0) { // already Inf
-               cost[IDX(i,j)] = -1.0; // Inf
-               continue;
-            }
-            else {
-               sum -= widths_trim[j-1];
-               sum += widths_orig[j-1];
-            }
-         }
-         sum += widths_trim[j];
-         int ct = width_val - sum;
-         if (i == 0) ct -= add_para_1;
-         else        ct -= add_para_n;
-
-         if (j == nwords-1) { // last line == cost 0
-            if (j == i || ct >= 0)
-               cost[IDX(i,j)] = 0.0;
-            else
-               cost[IDX(i,j)] = -1.0/*Inf*/;
-         }
-         else if (j == i)
-            // some words don't fit in a line at all -> cost 0.0
-            cost[IDX(i,j)] = (ct < 0) ? 0.0 : pow((double)ct, exponent_val);
-         else
-            cost[IDX(i,j)] = (ct < 0) ? -1.0/*"Inf"*/ : pow((double)ct, exponent_val);
-      }
-   }
-
-   vector<double> f(nwords); // f[j] == total cost of  (optimally) printing words 0..j
-   vector<bool> where(nwords*nwords, false); // where[IDX(i,j)] == false iff
-                                             // we don't wrap after i-th word, i<=j
-                                             // when (optimally) printing words 0..j
-
-   for (int j=0; j<nwords; ++j) {
-      if (cost[IDX(0,j)] >= 0.0) {
+   // (number of "blank" codepoints ^ exponent_val); the cost of printing
+   // words i..j in a single line is computed on the fly;
+   // the last line costs 0; some words don't fit in a line at all -> cost 0
+#define STRI__WRAP_BLANKS(i,j) \
+   ((double)((i) == 0 ? add_para_1 : add_para_n) + sum_orig[j] - sum_orig[i] + widths_trim[j])
+
+   vector<double> f(nwords); // f[j] == total cost of (optimally) printing words 0..j
+   vector<R_len_t> prev(nwords, -1); // prev[j] == the word after which we wrap
+                                     // for the last time when (optimally)
+                                     // printing words 0..j; -1 if never
+
+   // words k+1..j fit in a line iff k >= i or k == j-1;
+   // i is non-decreasing in j, hence the overall time complexity
+   // is O(nwords * (max number of words in a line))
+   R_len_t i = 0;
+   for (R_len_t j=0; j<nwords; ++j) {
+      double ct = width_val - STRI__WRAP_BLANKS(0,j);
+      if (j == 0 || ct >= 0.0) {
          // no breaking needed: words 0..j fit in one line
-         f[j] = cost[IDX(0,j)];
+         f[j] = (j == nwords-1 || ct < 0.0) ? 0.0 : pow(ct, exponent_val);
          continue;
       }
 
-      // let i = optimal way of printing of words 0..i + printing i+1..j
-      int i = 0;
-      while (i <= j) {
-         if (cost[IDX(i+1,j)] >= 0.0) break;
+      // let k = optimal way of printing of words 0..k + printing k+1..j
+      while (i < j-1 && width_val - STRI__WRAP_BLANKS(i+1,j) < 0.0)
          ++i;
-      }
 
-      double best_i = f[i] + cost[IDX(i+1,j)];
-      for (int k=i+1; k<j; ++k) {
-         if (cost[IDX(k+1,j)] < 0.0) continue;
-         double best_cur = f[k] + cost[IDX(k+1,j)];
-         if (best_cur < best_i) {
-            best_i = best_cur;
-            i = k;
+      for (R_len_t k=i; k<j; ++k) {
+         ct = width_val - STRI__WRAP_BLANKS(k+1,j);
+         double best_cur = f[k] +
+            ((j == nwords-1 || ct < 0.0) ? 0.0 : pow(ct, exponent_val));
+         if (k == i || best_cur < f[j]) {
+            f[j] = best_cur;
+            prev[j] = k;
          }
       }
-      for (int k=0; k<i; ++k)
-         where[IDX(k,j)] = where[IDX(k,i)];
-      where[IDX(i,j)] = true;
-      f[j] = best_i;
    }
+#undef STRI__WRAP_BLANKS
 
-   //result is in the last row of where...
-   for (int k=0; k<nwords; ++k)
-      if (where[IDX(k, nwords-1)])
-         wrap_after.push_back(k);
+   for (R_len_t k=prev[nwords-1]; k >= 0; k=prev[k])
+      wrap_after.push_front(k);
 }
 
 